@@ -0,0 +1,43 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_EXPOSURE_FUSION_HPP
+#define BIT_PARALLEL_ARGUS_EXPOSURE_FUSION_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_opencv_video_capture.hpp"
+
+//
+// notes 1, a fast single scale exposure fusion, intended for merging the frames returned by ArgusVideoCapture::captureBurst()
+//       2, each pixel is a weighted average of the exposures, the weight being the well exposedness of its luma value,
+//          i.e. a gaussian centred on mid grey, this is evaluated using a lookup table
+//       3, unlike cv::MergeMertens no laplacian pyramid is used, so it is much faster but may show halos around hard edges
+//       4, the rows are merged in parallel using cv::parallel_for_
+//
+
+namespace bpl
+{
+    class ArgusExposureFusion
+    {
+        private:
+            std::array<float, 256> weightLookup;
+            const bool multiThreaded;
+
+        public:
+            ArgusExposureFusion(const float sigma = 0.2f, const bool multiThreaded = true);
+
+            void merge(const ArgusVideoCapture::BurstGroup& burst, cv::Mat& merged) const;
+            void merge(const std::vector<cv::Mat>& exposures, cv::Mat& merged) const;
+
+        private:
+            void mergeRows(const std::vector<cv::Mat>& exposures, cv::Mat& merged, const cv::Range& rows) const;
+    };
+}
+
+#endif
@@ -0,0 +1,335 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_FRAME_PIPELINE_HPP
+#define BIT_PARALLEL_ARGUS_FRAME_PIPELINE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_opencv_video_capture.hpp"
+#include "argus_work_stealing_pool.hpp"
+
+//
+// notes 1, an ordered parallel frame processing pipeline, a dedicated thread grabs and retrieves frames, copies each one into a
+//          pooled slot and dispatches it to the processor callback on a work stealing pool
+//       2, the results are held in a reorder buffer keyed by the capture id and are returned by next() in capture order
+//       3, the in-flight depth bounds the number of frames that are being processed or are waiting in the reorder buffer, when
+//          this is reached the acquisition thread stops grabbing, so frames are dropped by the Argus mailbox rather than queued
+//       4, the ArgusVideoCapture instance must not be used elsewhere between start() and stop()
+//       5, implemented as a header only template as the result type is defined by the user, it must be default constructible
+//       6, when the processor throws, the exception is stored in the error of that frame's output, which is returned by next() in
+//          capture order as usual, its result is default constructed and must not be used, use std::rethrow_exception() if required
+//
+
+namespace bpl
+{
+    template<typename Result>
+    class ArgusFramePipeline
+    {
+        public:
+            // note, all of the stage timings are in nanoseconds
+            //
+            struct StageTimings
+            {
+                uint64_t acquire;
+                uint64_t queued;
+                uint64_t process;
+                uint64_t reorder;
+            };
+
+            struct Output
+            {
+                uint32_t captureId;
+                uint64_t timestamp;
+                Result result;
+                StageTimings timings;
+                std::exception_ptr error;
+            };
+
+            using Processor = std::function<Result(const cv::Mat& frame, const uint32_t captureId, const uint64_t timestamp)>;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct InFlight
+            {
+                int32_t slot;
+                uint64_t timestamp;
+                Result result;
+                StageTimings timings;
+                Clock::time_point completed;
+                bool done;
+                std::exception_ptr error;
+            };
+
+            ArgusVideoCapture& capture;
+            const Processor processor;
+            const int32_t inFlightDepth, format;
+            std::vector<cv::Mat> slots;
+            std::vector<int32_t> freeSlots;
+            std::deque<uint32_t> captureOrder;
+            std::map<uint32_t, InFlight> reorderBuffer;
+            std::mutex mutex;
+            std::condition_variable slotAvailable, outputAvailable;
+            std::exception_ptr failure;
+            std::thread acquisitionThread;
+            bool running;
+
+            // note, declared last so that the workers are joined before any of the state that they use is destroyed
+            //
+            ArgusWorkStealingPool pool;
+
+        public:
+            ArgusFramePipeline(ArgusVideoCapture& capture, const Processor& processor, const int32_t inFlightDepth, const int32_t threadCount,
+                const int32_t format = ArgusVideoCapture::PIXEL_FORMAT_BGRA);
+            ~ArgusFramePipeline();
+
+            void start();
+            void stop();
+            bool next(Output& output, const uint64_t timeout = 5000000000UL);
+
+            int32_t getInFlightDepth() const;
+            int32_t getThreadCount() const;
+
+        private:
+            void acquire();
+            void process(const int32_t slot, const uint32_t captureId, const uint64_t timestamp, const Clock::time_point dispatched);
+            bool allDone() const;
+
+            static uint64_t nanoseconds(const Clock::time_point from, const Clock::time_point to);
+    };
+}
+
+template<typename Result>
+bpl::ArgusFramePipeline<Result>::ArgusFramePipeline(ArgusVideoCapture& capture, const Processor& processor, const int32_t inFlightDepth,
+    const int32_t threadCount, const int32_t format):
+    capture(capture), processor(processor), inFlightDepth(inFlightDepth), format(format), slots(inFlightDepth > 0 ? inFlightDepth : 0),
+    running(false), pool(threadCount) {
+
+    if (inFlightDepth < 1) throw std::string("The frame pipeline in-flight depth must be at least 1");
+}
+
+template<typename Result>
+bpl::ArgusFramePipeline<Result>::~ArgusFramePipeline()
+{
+    stop();
+}
+
+// note, any outputs that were not collected before a prior stop() are discarded
+//
+template<typename Result>
+void bpl::ArgusFramePipeline<Result>::start()
+{
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        if (running) throw std::string("The frame pipeline has already been started");
+    }
+
+    // notes 1, the acquisition thread may have exited due to an error without stop() being called
+    //       2, in which case frames may still be being processed, these must complete before their slots and entries are reset
+    //
+    if (acquisitionThread.joinable()) acquisitionThread.join();
+
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    outputAvailable.wait(lock, [&] { return allDone(); });
+
+    captureOrder.clear();
+    reorderBuffer.clear();
+    freeSlots.clear();
+    for (auto i = 0; i < inFlightDepth; i++) freeSlots.push_back(i);
+
+    failure = nullptr;
+    running = true;
+    acquisitionThread = std::thread(&ArgusFramePipeline::acquire, this);
+}
+
+// note, waits for the frames being processed to complete, their outputs can still be collected using next()
+//
+template<typename Result>
+void bpl::ArgusFramePipeline<Result>::stop()
+{
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        running = false;
+    }
+
+    slotAvailable.notify_all();
+    if (acquisitionThread.joinable()) acquisitionThread.join();
+
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    outputAvailable.wait(lock, [&] { return allDone(); });
+}
+
+// notes 1, blocks until the next output in capture order is available, returns false on timeout or once stopped and drained
+//       2, rethrows any exception raised by the acquisition thread, once the frames acquired before it have been returned
+//
+template<typename Result>
+bool bpl::ArgusFramePipeline<Result>::next(Output& output, const uint64_t timeout)
+{
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    outputAvailable.wait_for(lock, std::chrono::nanoseconds(timeout), [&] {
+        if (captureOrder.empty()) return failure || !running;
+
+        return reorderBuffer.at(captureOrder.front()).done;
+    });
+
+    if (captureOrder.empty())
+    {
+        if (!failure) return false;
+
+        auto rethrown = failure;
+        failure = nullptr;
+        std::rethrow_exception(rethrown);
+    }
+
+    const auto entry = reorderBuffer.find(captureOrder.front());
+    auto& inFlight = entry->second;
+    if (!inFlight.done) return false;
+
+    output.captureId = entry->first;
+    output.timestamp = inFlight.timestamp;
+    output.result = std::move(inFlight.result);
+    output.timings = inFlight.timings;
+    output.timings.reorder = nanoseconds(inFlight.completed, Clock::now());
+    output.error = inFlight.error;
+
+    freeSlots.push_back(inFlight.slot);
+    reorderBuffer.erase(entry);
+    captureOrder.pop_front();
+    lock.unlock();
+
+    slotAvailable.notify_one();
+    return true;
+}
+
+template<typename Result>
+int32_t bpl::ArgusFramePipeline<Result>::getInFlightDepth() const
+{
+    return inFlightDepth;
+}
+
+template<typename Result>
+int32_t bpl::ArgusFramePipeline<Result>::getThreadCount() const
+{
+    return pool.getThreadCount();
+}
+
+//
+// private methods
+//
+
+template<typename Result>
+void bpl::ArgusFramePipeline<Result>::acquire()
+{
+    while (true)
+    {
+        auto slot = int32_t(0);
+        {
+            auto lock = std::unique_lock<std::mutex>(mutex);
+            slotAvailable.wait(lock, [&] { return !running || !freeSlots.empty(); });
+            if (!running) return;
+
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        // note, the retrieved frame is only valid until the next grab(), hence the copy into the pooled slot
+        //
+        const auto started = Clock::now();
+        try
+        {
+            capture.grab();
+            capture.retrieve(format).copyTo(slots[slot]);
+        }
+        catch (...)
+        {
+            {
+                const auto lock = std::lock_guard<std::mutex>(mutex);
+                failure = std::current_exception();
+                freeSlots.push_back(slot);
+                running = false;
+            }
+
+            outputAvailable.notify_all();
+            return;
+        }
+
+        const auto captureId = capture.getCaptureId();
+        const auto timestamp = capture.getTimestamp();
+        const auto dispatched = Clock::now();
+        {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            auto& inFlight = reorderBuffer[captureId];
+            inFlight.slot = slot;
+            inFlight.timestamp = timestamp;
+            inFlight.timings = StageTimings{nanoseconds(started, dispatched), 0, 0, 0};
+            inFlight.done = false;
+            inFlight.error = nullptr;
+            captureOrder.push_back(captureId);
+        }
+
+        pool.submit([this, slot, captureId, timestamp, dispatched] { process(slot, captureId, timestamp, dispatched); });
+    }
+}
+
+// note, the slot is not reused until its output has been collected by next(), so it can be read without holding the lock
+//
+template<typename Result>
+void bpl::ArgusFramePipeline<Result>::process(const int32_t slot, const uint32_t captureId, const uint64_t timestamp, const Clock::time_point dispatched)
+{
+    const auto started = Clock::now();
+    auto result = Result();
+    auto error = std::exception_ptr();
+    try
+    {
+        result = processor(slots[slot], captureId, timestamp);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    const auto completed = Clock::now();
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        auto& inFlight = reorderBuffer.at(captureId);
+        inFlight.result = std::move(result);
+        inFlight.timings.queued = nanoseconds(dispatched, started);
+        inFlight.timings.process = nanoseconds(started, completed);
+        inFlight.completed = completed;
+        inFlight.done = true;
+        inFlight.error = error;
+    }
+
+    outputAvailable.notify_all();
+}
+
+// note, must be called with the mutex held
+//
+template<typename Result>
+bool bpl::ArgusFramePipeline<Result>::allDone() const
+{
+    for (const auto& [captureId, inFlight] : reorderBuffer) if (!inFlight.done) return false;
+    return true;
+}
+
+template<typename Result>
+uint64_t bpl::ArgusFramePipeline<Result>::nanoseconds(const Clock::time_point from, const Clock::time_point to)
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+#endif
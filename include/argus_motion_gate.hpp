@@ -0,0 +1,48 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_MOTION_GATE_HPP
+#define BIT_PARALLEL_ARGUS_MOTION_GATE_HPP
+
+#include <cstdint>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_opencv_video_capture.hpp"
+
+//
+// notes 1, a cheap change detector intended to be used between ArgusVideoCapture::grab() and ArgusVideoCapture::retrieve()
+//          so that unchanged frames can be skipped before any full resolution conversion takes place
+//       2, operates on a small subsampled luma plane, see ArgusVideoCapture::retrieve(PIXEL_FORMAT_GREY, size), the luma plane
+//          is split into a grid of regions and the mean absolute difference of each region against a reference is thresholded
+//       3, the reference is only replaced when a change is reported, so slow drifts will eventually be reported as a change
+//
+
+namespace bpl
+{
+    class ArgusMotionGate
+    {
+        private:
+            const cv::Size2i sampleSize, gridSize;
+            const double regionThreshold;
+            const int32_t minChangedRegions;
+            cv::Mat reference, difference, regionDifferences, changeMask;
+            int32_t changedRegionCount;
+
+        public:
+            ArgusMotionGate(const cv::Size2i& sampleSize, const cv::Size2i& gridSize, const double regionThreshold, const int32_t minChangedRegions = 1);
+
+            bool hasChanged(ArgusVideoCapture& capture);
+            bool hasChanged(const cv::Mat& luma);
+            void reset();
+
+            cv::Size2i getSampleSize() const;
+            cv::Size2i getGridSize() const;
+            const cv::Mat& getChangeMask() const;
+            const cv::Mat& getRegionDifferences() const;
+            int32_t getChangedRegionCount() const;
+    };
+}
+
+#endif
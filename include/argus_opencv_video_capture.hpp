@@ -6,10 +6,12 @@
 #define BIT_PARALLEL_ARGUS_OPENCV_VIDEO_CAPTURE_HPP
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <Argus/Argus.h>
+#include <EGLStream/ArgusCaptureMetadata.h>
 #include <EGLStream/EGLStream.h>
 #include <EGLStream/NV/ImageNativeBuffer.h>
 #include <opencv2/opencv.hpp>
@@ -20,7 +22,76 @@ namespace bpl
 {
     class ArgusVideoCapture
     {
+        public:
+            // note, this ordering must be maintained with the NvBufferApi traits and the cvPixelTypes array in the implementation
+            //
+            const static inline int32_t PIXEL_FORMAT_BGRA = 0;
+            const static inline int32_t PIXEL_FORMAT_RGBA = 1;
+            const static inline int32_t PIXEL_FORMAT_GREY = 2;
+
+            const static inline int32_t MAX_BURST_LENGTH = 8;
+            const static inline int32_t MAX_LEASED_BUFFERS = 4;
+
+            // note, the image is only valid until the next call to captureBurst(), clone() it if required
+            //
+            struct BurstFrame
+            {
+                cv::Mat image;
+                uint32_t captureId;
+                uint64_t timestamp;
+                uint64_t exposureTime;
+                float analogGain;
+                float ispDigitalGain;
+            };
+
+            struct BurstGroup
+            {
+                uint32_t burstId;
+                std::vector<BurstFrame> frames;
+            };
+
+            // note, the lease keeps the DMA buffer that image refers to from being reused, it must not outlive the capture instance
+            //
+            struct LeasedImage
+            {
+                cv::Mat image;
+                std::shared_ptr<void> lease;
+                uint32_t captureId;
+                uint64_t timestamp;
+            };
+
         private:
+            // a lazily created, CPU mapped conversion of the current frame, one per requested pixel format and size
+            // notes 1, colourFormat holds the NvBufferApi::ColourFormat value, stored as an int32_t to keep this header JetPack agnostic
+            //       2, frameCount records the grab() that the buffer contents were converted from
+            //       3, region is the area cropped from the frame, it is empty when the whole frame is converted
+            //
+            struct ConvertedImage
+            {
+                int32_t format;
+                Argus::Size2D<uint32_t> size;
+                int32_t colourFormat;
+                int32_t cvType;
+                int32_t dmaBufferFd;
+                void* buffer;
+                uint32_t pitch;
+                uint64_t frameCount;
+                cv::Rect region;
+            };
+
+            // a pre-built burst capture request, the settings instance holds references to the interface pointers
+            // note, hence these are heap allocated so that their addresses remain stable
+            //
+            struct BurstRequest
+            {
+                Argus::UniqueObj<Argus::Request> request;
+                Argus::ISourceSettings* iSourceSettings;
+                Argus::IAutoControlSettings* iAutoControlSettings;
+                ArgusCameraSettings settings;
+
+                BurstRequest(): iSourceSettings(nullptr), iAutoControlSettings(nullptr), settings(iSourceSettings, iAutoControlSettings) {}
+            };
+
             const static inline uint64_t ONE_SECOND_IN_NANOSECONDS = 1000000000UL;
             const static inline uint64_t FIVE_SECONDS_IN_NANOSECONDS = 5000000000UL;
 
@@ -40,12 +111,20 @@ namespace bpl
             Argus::UniqueObj<EGLStream::Frame> frame;
             EGLStream::IFrame* iFrame;
             EGLStream::Image* image;
+            EGLStream::NV::IImageNativeBuffer* iNativeBuffer;
             Argus::UniqueObj<Argus::Request> request;
             Argus::ISourceSettings* iSourceSettings;
             Argus::IAutoControlSettings* iAutoControlSettings;
             ArgusCameraSettings argusCameraSettings;
-            int32_t dmaBufferFd;
-            void *cvImageBuffer;
+            std::vector<ConvertedImage> convertedImages;
+            ConvertedImage nativeImage;
+            std::vector<std::shared_ptr<ConvertedImage>> leasedImages;
+            Argus::UniqueObj<Argus::OutputStream> burstStream;
+            Argus::UniqueObj<EGLStream::FrameConsumer> burstConsumer;
+            EGLStream::IFrameConsumer* iBurstFrameConsumer;
+            std::vector<std::unique_ptr<BurstRequest>> burstRequests;
+            std::vector<ConvertedImage> burstImages;
+            uint64_t frameCount;
             uint32_t captureId;
             uint64_t timestamp;
 
@@ -53,7 +132,12 @@ namespace bpl
             ArgusVideoCapture(const int32_t deviceIndex, const int32_t sensorModeIndex);
             ~ArgusVideoCapture();
 
-            cv::Mat grab();
+            void grab();
+            cv::Mat retrieve(const int32_t format = PIXEL_FORMAT_BGRA);
+            cv::Mat retrieve(const int32_t format, const cv::Size2i& size);
+            cv::Mat retrieve(const int32_t format, const cv::Size2i& size, const cv::Rect& region);
+            cv::Mat read(const int32_t format = PIXEL_FORMAT_BGRA);
+            LeasedImage retrieveLeased(const int32_t format, const cv::Size2i& size);
             cv::Size2i getResolution() const;
             uint64_t getTimestamp() const;
             uint32_t getCaptureId() const;
@@ -62,6 +146,19 @@ namespace bpl
 
             ArgusCameraSettings& getCameraSettings();
             bool restart();
+
+            ArgusCameraSettings& addBurstRequest();
+            void clearBurstRequests();
+            int32_t getBurstLength() const;
+            BurstGroup captureBurst(const int32_t format = PIXEL_FORMAT_BGRA);
+
+        protected:
+            cv::Mat retrieveConverted(const int32_t format, const int32_t colourFormat, const int32_t cvType, const cv::Size2i& size);
+
+        private:
+            void createBurstStream();
+            void convert(EGLStream::NV::IImageNativeBuffer* iImageNativeBuffer, ConvertedImage& converted);
+            static void release(ConvertedImage& converted);
     };
 }
 
@@ -0,0 +1,62 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_ROI_EXTRACTOR_HPP
+#define BIT_PARALLEL_ARGUS_ROI_EXTRACTOR_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_opencv_video_capture.hpp"
+
+//
+// notes 1, extracts a list of regions of interest, scaling and converting each one into a pooled output buffer
+//       2, extract(capture, ...) uses the hardware, each region is cropped, scaled and converted from the native copy of the grabbed
+//          frame into its own DMA buffer, see ArgusVideoCapture::retrieve(format, size, region), so no full resolution BGRA
+//          conversion takes place and the CPU only reads the region sized results, the BGR and RGB outputs are then converted
+//          from the hardware BGRA and RGBA outputs on the CPU, optionally in parallel
+//       3, the hardware crops are separate transforms, so overlapping regions are read by the hardware once per region, this is
+//          not a single pass over the source planes
+//       4, extract(bgraFrame, ...) is the software path, for frames that are already in CPU memory, each region is resized and
+//          converted independently from a view onto the frame, optionally in parallel with one region per task
+//       5, the output buffers are reused for each call, so once the pools have grown to fit the region list nothing is allocated
+//          the returned cv::Mat instances are therefore only valid until the next call to extract(), clone() them if required
+//
+
+namespace bpl
+{
+    class ArgusRoiExtractor
+    {
+        public:
+            const static inline int32_t OUTPUT_FORMAT_BGRA = 0;
+            const static inline int32_t OUTPUT_FORMAT_BGR = 1;
+            const static inline int32_t OUTPUT_FORMAT_RGB = 2;
+            const static inline int32_t OUTPUT_FORMAT_GREY = 3;
+
+            struct RegionOfInterest
+            {
+                cv::Rect region;
+                cv::Size2i size;
+                int32_t format;
+            };
+
+        private:
+            const bool multiThreaded;
+            std::vector<cv::Mat> outputPool, scratchPool, retrieved, outputs;
+
+        public:
+            ArgusRoiExtractor(const bool multiThreaded = true);
+
+            const std::vector<cv::Mat>& extract(ArgusVideoCapture& capture, const std::vector<RegionOfInterest>& regions);
+            const std::vector<cv::Mat>& extract(const cv::Mat& bgraFrame, const std::vector<RegionOfInterest>& regions);
+
+        private:
+            void validate(const cv::Size2i& frameSize, const std::vector<RegionOfInterest>& regions);
+            void extractRegion(const cv::Mat& bgraFrame, const RegionOfInterest& roi, cv::Mat& scratch, cv::Mat& output) const;
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_TYPED_VIDEO_CAPTURE_HPP
+#define BIT_PARALLEL_ARGUS_TYPED_VIDEO_CAPTURE_HPP
+
+#include <cstdint>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_opencv_video_capture.hpp"
+
+//
+// notes 1, a capture front end parameterised on the output pixel format, the retrieved frames are typed cv::Mat_<> instances
+//       2, the DMA buffer colour format and OpenCV type are resolved at compile time, so retrieve() has no runtime format checks
+//       3, the member definitions live in the library and are explicitly instantiated for the pixel formats below
+//          to add a format, define a tag here, add its colour format to the NvBufferApi traits and instantiate it in the library
+//
+
+namespace bpl
+{
+    struct PixelFormatBGRA
+    {
+        using Pixel = cv::Vec4b;
+        const static inline int32_t ID = ArgusVideoCapture::PIXEL_FORMAT_BGRA;
+    };
+
+    struct PixelFormatRGBA
+    {
+        using Pixel = cv::Vec4b;
+        const static inline int32_t ID = ArgusVideoCapture::PIXEL_FORMAT_RGBA;
+    };
+
+    struct PixelFormatGrey
+    {
+        using Pixel = uint8_t;
+        const static inline int32_t ID = ArgusVideoCapture::PIXEL_FORMAT_GREY;
+    };
+
+    template<typename PixelFormat>
+    class ArgusTypedVideoCapture : public ArgusVideoCapture
+    {
+        public:
+            using Pixel = typename PixelFormat::Pixel;
+            using Frame = cv::Mat_<Pixel>;
+
+            ArgusTypedVideoCapture(const int32_t deviceIndex, const int32_t sensorModeIndex);
+
+            Frame retrieve();
+            Frame retrieve(const cv::Size2i& size);
+            Frame read();
+    };
+
+    extern template class ArgusTypedVideoCapture<PixelFormatBGRA>;
+    extern template class ArgusTypedVideoCapture<PixelFormatRGBA>;
+    extern template class ArgusTypedVideoCapture<PixelFormatGrey>;
+}
+
+#endif
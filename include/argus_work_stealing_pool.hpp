@@ -0,0 +1,56 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_WORK_STEALING_POOL_HPP
+#define BIT_PARALLEL_ARGUS_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// notes 1, a fixed size thread pool where each worker has its own task queue, submitted tasks are distributed round robin
+//       2, a worker takes tasks from the front of its own queue and when empty steals from the back of the other queues
+//       3, the destructor completes any outstanding tasks before joining the worker threads
+//
+
+namespace bpl
+{
+    class ArgusWorkStealingPool
+    {
+        private:
+            struct WorkQueue
+            {
+                std::mutex mutex;
+                std::deque<std::function<void()>> tasks;
+            };
+
+            std::vector<std::unique_ptr<WorkQueue>> queues;
+            std::vector<std::thread> workers;
+            std::mutex wakeMutex;
+            std::condition_variable wakeCondition;
+            std::atomic<uint32_t> nextQueue;
+            std::atomic<int64_t> pendingTasks;
+            bool running;
+
+        public:
+            ArgusWorkStealingPool(const int32_t threadCount);
+            ~ArgusWorkStealingPool();
+
+            void submit(std::function<void()> task);
+            int32_t getThreadCount() const;
+
+        private:
+            void run(const int32_t index);
+            bool takeTask(const int32_t index, std::function<void()>& task);
+    };
+}
+
+#endif
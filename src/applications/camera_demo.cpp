@@ -2,18 +2,261 @@
 // (c) Bit Parallel Ltd, August 2023
 //
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <stdexcept>
 #include <tuple>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
 
 #include <opencv2/opencv.hpp>
 
 #include "argus_camera_settings.hpp"
-#include "argus_opencv_video_capture.hpp"
+#include "argus_typed_video_capture.hpp"
+
+using DemoVideoCapture = bpl::ArgusTypedVideoCapture<bpl::PixelFormatBGRA>;
+
+// soak test settings, a failure is reported if a stall or any growth beyond these limits is detected
+// notes 1, the first report sample is used as the baseline, i.e. after all of the conversion buffers have been allocated
+//       2, a small open file descriptor allowance is made for the Argus client, a leaked dmaBufferFd per frame or per restart
+//          will quickly exceed this
+//
+static const uint64_t SOAK_SETTINGS_INTERVAL_NANOSECONDS = 10000000000UL;
+static const uint64_t SOAK_REPORT_INTERVAL_NANOSECONDS = 60000000000UL;
+static const uint64_t SOAK_STALL_INTERVAL_NANOSECONDS = 1000000000UL;
+static const uint64_t SOAK_MAX_RESIDENT_SET_GROWTH_BYTES = 32UL * 1024UL * 1024UL;
+static const int32_t SOAK_MAX_OPEN_FILE_DESCRIPTOR_GROWTH = 4;
+
+struct SoakSample
+{
+    double elapsedSeconds;
+    uint64_t frames;
+    double fps;
+    double meanFrameIntervalMs;
+    double maxFrameIntervalMs;
+    uint64_t dropped;
+    double dropRate;
+    uint64_t residentSetBytes;
+    int32_t openFileDescriptors;
+    uint32_t restarts;
+};
+
+static uint64_t readResidentSetBytes()
+{
+    auto statm = std::ifstream("/proc/self/statm");
+    auto size = uint64_t(0), resident = uint64_t(0);
+    statm >> size >> resident;
+
+    return resident * uint64_t(sysconf(_SC_PAGESIZE));
+}
+
+// note, excludes the ., .. and the directory handle used to perform the count
+//
+static int32_t countOpenFileDescriptors()
+{
+    auto* directory = opendir("/proc/self/fd");
+    if (!directory) return -1;
+
+    auto count = int32_t(0);
+    while (auto* entry = readdir(directory)) if (entry->d_name[0] != '.') count++;
+    closedir(directory);
+
+    return count - 1;
+}
+
+static void writeSoakReport(const std::string& fileName, const uint32_t seed, const std::vector<SoakSample>& samples, const std::string& result)
+{
+    const auto json = (fileName.size() >= 5) && (fileName.compare(fileName.size() - 5, 5, ".json") == 0);
+    auto report = std::ofstream(fileName, std::ios::trunc);
+    report << std::fixed << std::setprecision(3);
+
+    if (json)
+    {
+        report << "{\n  \"seed\": " << seed << ",\n  \"result\": \"" << result << "\",\n  \"samples\": [";
+        for (auto i = 0; i < samples.size(); i++)
+        {
+            const auto& sample = samples[i];
+            report << (i ? ",\n" : "\n") << "    {\"elapsed_s\": " << sample.elapsedSeconds << ", \"frames\": " << sample.frames << ", \"fps\": " << sample.fps;
+            report << ", \"mean_interval_ms\": " << sample.meanFrameIntervalMs << ", \"max_interval_ms\": " << sample.maxFrameIntervalMs;
+            report << ", \"dropped\": " << sample.dropped << ", \"drop_rate\": " << sample.dropRate << ", \"rss_bytes\": " << sample.residentSetBytes;
+            report << ", \"open_fds\": " << sample.openFileDescriptors << ", \"restarts\": " << sample.restarts << "}";
+        }
+
+        report << "\n  ]\n}\n";
+    }
+    else
+    {
+        report << "# seed: " << seed << ", result: " << result << "\n";
+        report << "elapsed_s,frames,fps,mean_interval_ms,max_interval_ms,dropped,drop_rate,rss_bytes,open_fds,restarts\n";
+        for (const auto& sample : samples)
+        {
+            report << sample.elapsedSeconds << "," << sample.frames << "," << sample.fps << "," << sample.meanFrameIntervalMs << "," << sample.maxFrameIntervalMs << ",";
+            report << sample.dropped << "," << sample.dropRate << "," << sample.residentSetBytes << "," << sample.openFileDescriptors << "," << sample.restarts << "\n";
+        }
+    }
+}
+
+// notes 1, a headless long run test, frames are grabbed and retrieved until the duration or frame count is reached
+//       2, the frame rate, exposure, gain and white balance mode are randomised every SOAK_SETTINGS_INTERVAL_NANOSECONDS,
+//          followed by a restart(), the seed is reported so that a failing run can be repeated
+//       3, the report file is rewritten after each sample so that it is always complete, .json selects JSON, otherwise CSV
+//
+static bool runSoakTest(DemoVideoCapture& capture, const uint64_t durationSeconds, const uint64_t frameLimit, const std::string& reportFileName)
+{
+    auto& settings = capture.getCameraSettings();
+    const auto exposureTimeRange = settings.getExposureTimeRange();
+    const auto gainRange = settings.getGainRange();
+    const double frameRates[] = {10.0, 15.0, 20.0, 30.0};
+
+    const auto seed = std::random_device()();
+    auto random = std::mt19937(seed);
+    std::cout << "Soak test started, duration: " << durationSeconds << "s, frame limit: " << frameLimit << ", seed: " << seed << "\n";
+
+    using Clock = std::chrono::steady_clock;
+    const auto started = Clock::now();
+    const auto elapsedNanoseconds = [&]() { return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count()); };
+
+    auto samples = std::vector<SoakSample>();
+    auto failure = std::string();
+    auto totalFrames = uint64_t(0), periodFrames = uint64_t(0), periodIntervals = uint64_t(0), periodDropped = uint64_t(0);
+    auto periodIntervalSum = uint64_t(0), periodMaxInterval = uint64_t(0), periodStarted = uint64_t(0);
+    auto nextSettingsChange = SOAK_SETTINGS_INTERVAL_NANOSECONDS, nextReport = SOAK_REPORT_INTERVAL_NANOSECONDS;
+    auto previousCaptureId = uint32_t(0);
+    auto previousTimestamp = uint64_t(0);
+    auto restarts = uint32_t(0);
+    auto afterRestart = true;
+
+    const auto takeSample = [&](const uint64_t now) {
+        const auto periodSeconds = std::max(1.0e-9, (now - periodStarted) / 1000000000.0);
+        auto sample = SoakSample();
+        sample.elapsedSeconds = now / 1000000000.0;
+        sample.frames = totalFrames;
+        sample.fps = periodFrames / periodSeconds;
+        sample.meanFrameIntervalMs = periodIntervals ? ((periodIntervalSum / double(periodIntervals)) / 1000000.0) : 0.0;
+        sample.maxFrameIntervalMs = periodMaxInterval / 1000000.0;
+        sample.dropped = periodDropped;
+        sample.dropRate = (periodFrames + periodDropped) ? (periodDropped / double(periodFrames + periodDropped)) : 0.0;
+        sample.residentSetBytes = readResidentSetBytes();
+        sample.openFileDescriptors = countOpenFileDescriptors();
+        sample.restarts = restarts;
+        samples.push_back(sample);
+
+        std::cout << std::fixed << std::setprecision(2) << "[" << sample.elapsedSeconds << "s] Frames: " << sample.frames << ", FPS: " << sample.fps;
+        std::cout << ", Interval (mean/max): " << sample.meanFrameIntervalMs << "/" << sample.maxFrameIntervalMs << "ms, Dropped: " << sample.dropped;
+        std::cout << ", RSS: " << (sample.residentSetBytes / 1024) << "KB, Open FDs: " << sample.openFileDescriptors << ", Restarts: " << sample.restarts << "\n";
+
+        // note, an earlier failure, i.e. a stall, is retained as the reported cause
+        //
+        const auto& baseline = samples.front();
+        if (failure.empty() && (sample.residentSetBytes > (baseline.residentSetBytes + SOAK_MAX_RESIDENT_SET_GROWTH_BYTES)))
+        {
+            failure = "Resident set size has grown from " + std::to_string(baseline.residentSetBytes) + " to " + std::to_string(sample.residentSetBytes) + " bytes";
+        }
+        else if (failure.empty() && (sample.openFileDescriptors > (baseline.openFileDescriptors + SOAK_MAX_OPEN_FILE_DESCRIPTOR_GROWTH)))
+        {
+            failure = "Open file descriptors have grown from " + std::to_string(baseline.openFileDescriptors) + " to " + std::to_string(sample.openFileDescriptors);
+        }
+
+        if (!reportFileName.empty()) writeSoakReport(reportFileName, seed, samples, failure.empty() ? "running" : "failed");
+
+        periodFrames = periodIntervals = periodDropped = periodIntervalSum = periodMaxInterval = 0;
+        periodStarted = now;
+    };
+
+    while (failure.empty())
+    {
+        auto now = elapsedNanoseconds();
+        if ((durationSeconds && (now >= (durationSeconds * 1000000000UL))) || (frameLimit && (totalFrames >= frameLimit))) break;
+
+        // notes 1, any Argus error whilst changing the settings or restarting is recorded as the failure, so the report is still completed
+        //       2, grab() throws after a 5 second timeout, this is reported as a stall
+        //
+        try
+        {
+            if (now >= nextSettingsChange)
+            {
+                const auto frameRate = frameRates[std::uniform_int_distribution<int32_t>(0, 3)(random)];
+                const auto minExposureTime = std::get<bpl::ArgusCameraSettings::MIN_VALUE>(exposureTimeRange);
+                const auto maxExposureTime = std::max(minExposureTime, std::min(std::get<bpl::ArgusCameraSettings::MAX_VALUE>(exposureTimeRange), uint64_t(1000000000.0 / frameRate)));
+                settings.setFrameRate(frameRate);
+                settings.setAutoWhiteBalanceMode(std::uniform_int_distribution<int32_t>(bpl::ArgusCameraSettings::AWB_MODE_AUTO, bpl::ArgusCameraSettings::AWB_MODE_SHADE)(random));
+                if (std::uniform_int_distribution<int32_t>(0, 1)(random))
+                {
+                    settings.setExposureTime(std::uniform_int_distribution<uint64_t>(minExposureTime, maxExposureTime)(random));
+                    settings.setGain(std::uniform_real_distribution<float>(std::get<bpl::ArgusCameraSettings::MIN_VALUE>(gainRange), std::get<bpl::ArgusCameraSettings::MAX_VALUE>(gainRange))(random));
+                }
+                else
+                {
+                    settings.setExposureTimeRange(exposureTimeRange);
+                    settings.setGainRange(gainRange);
+                }
+
+                capture.restart();
+                restarts++;
+                afterRestart = true;
+                nextSettingsChange = now + SOAK_SETTINGS_INTERVAL_NANOSECONDS;
+            }
+        }
+        catch (const std::string& message)
+        {
+            failure = "Settings change or restart failed, " + message;
+            break;
+        }
+
+        try
+        {
+            capture.read();
+        }
+        catch (const std::string& message)
+        {
+            failure = "Stall, " + message;
+            break;
+        }
+
+        const auto captureId = capture.getCaptureId();
+        const auto timestamp = capture.getTimestamp();
+        if (!afterRestart)
+        {
+            const auto interval = timestamp - previousTimestamp;
+            if (captureId > (previousCaptureId + 1)) periodDropped += captureId - previousCaptureId - 1;
+            periodIntervalSum += interval;
+            periodMaxInterval = std::max(periodMaxInterval, interval);
+            periodIntervals++;
+
+            if (interval > SOAK_STALL_INTERVAL_NANOSECONDS) failure = "Stall, the frame interval reached " + std::to_string(interval / 1000000) + "ms";
+        }
+
+        afterRestart = false;
+        previousCaptureId = captureId;
+        previousTimestamp = timestamp;
+        totalFrames++;
+        periodFrames++;
+
+        now = elapsedNanoseconds();
+        if (failure.empty() && (now >= nextReport))
+        {
+            takeSample(now);
+            nextReport = now + SOAK_REPORT_INTERVAL_NANOSECONDS;
+        }
+    }
+
+    if (periodFrames || samples.empty()) takeSample(elapsedNanoseconds());
+    if (!reportFileName.empty()) writeSoakReport(reportFileName, seed, samples, failure.empty() ? "passed" : "failed");
+
+    if (failure.empty()) std::cout << "Soak test passed, frames: " << totalFrames << ", restarts: " << restarts << "\n";
+    else std::cout << "Soak test failed: " << failure << "\n";
+
+    return failure.empty();
+}
 
 int32_t main(int32_t argc, char** argv)
 {
@@ -26,20 +269,30 @@ int32_t main(int32_t argc, char** argv)
             bpl::ArgusCameraSettings::displayAttachedCameraInfo();
             return 0;
         }
-        else if ((argc != 5) || (std::string(argv[1]) != "-d") || (std::string(argv[3]) != "-m"))
-        {
-            std::cout << "Invalid arguments, please use:\n";
-            std::cout << argv[0] << " -q, --query-camera-devices\n";
-            std::cout << argv[0] << " -d [#camera device] -m [#sensor mode]\n";
-            return 0;
-        }
 
+        // note, the optional -s, -f and -r arguments select the headless soak test mode
+        //
+        auto validArguments = (argc >= 5) && ((argc % 2) == 1) && (std::string(argv[1]) == "-d") && (std::string(argv[3]) == "-m");
+        auto soakSeconds = uint64_t(0), soakFrames = uint64_t(0);
+        auto reportFileName = std::string();
         auto camera = 0;
         auto sensorMode = 0;
         try
         {
-            camera = std::stoi(argv[2]);
-            sensorMode = std::stoi(argv[4]);
+            if (validArguments)
+            {
+                camera = std::stoi(argv[2]);
+                sensorMode = std::stoi(argv[4]);
+            }
+
+            for (auto i = 5; validArguments && (i < argc); i += 2)
+            {
+                const auto option = std::string(argv[i]);
+                if (option == "-s") soakSeconds = std::stoull(argv[i + 1]);
+                else if (option == "-f") soakFrames = std::stoull(argv[i + 1]);
+                else if (option == "-r") reportFileName = argv[i + 1];
+                else validArguments = false;
+            }
         }
         catch (const std::exception& ex)
         {
@@ -47,7 +300,17 @@ int32_t main(int32_t argc, char** argv)
             return 0;
         }
 
-        auto capture = bpl::ArgusVideoCapture(camera, sensorMode);
+        const auto soakTest = (soakSeconds > 0) || (soakFrames > 0);
+        if (!validArguments || (!soakTest && (argc != 5)))
+        {
+            std::cout << "Invalid arguments, please use:\n";
+            std::cout << argv[0] << " -q, --query-camera-devices\n";
+            std::cout << argv[0] << " -d [#camera device] -m [#sensor mode]\n";
+            std::cout << argv[0] << " -d [#camera device] -m [#sensor mode] -s [#soak seconds] -f [#soak frames] -r [report file, .csv or .json]\n";
+            return 0;
+        }
+
+        auto capture = DemoVideoCapture(camera, sensorMode);
         auto& settings = capture.getCameraSettings();
         settings.setFrameRate(30.0);
         settings.setAutoWhiteBalanceMode(bpl::ArgusCameraSettings::AWB_MODE_AUTO);
@@ -66,12 +329,14 @@ int32_t main(int32_t argc, char** argv)
         std::cout << "\tGain Range, Min: " << minGain << ", Max: " << maxGain << "\n";
         std::cout << std::endl;
 
+        if (soakTest) return runSoakTest(capture, soakSeconds, soakFrames, reportFileName) ? 0 : 1;
+
         const auto fpsLocation = cv::Point(6, 30);
         const auto fpsColour = cv::Scalar(0xff, 0xff, 0xff);
         auto previousTimestamp = uint64_t(0);
         while (true)
         {
-            auto cvFrame = capture.grab();
+            auto cvFrame = capture.read();
 
             auto fps = std::stringstream();
             fps << "FPS: " << std::fixed << std::setprecision(2) << (1000000000.0 / int32_t(capture.getTimestamp() - previousTimestamp));
@@ -98,5 +363,6 @@ int32_t main(int32_t argc, char** argv)
     catch (const std::string& message)
     {
         std::cout << "Error: " << message << "\n";
+        return 1;
     }
 }
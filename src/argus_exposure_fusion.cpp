@@ -0,0 +1,110 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include <cmath>
+#include <string>
+
+#include "argus_exposure_fusion.hpp"
+
+// note, a small offset is added to each weight so that pixels that are badly exposed in every frame are still averaged
+//
+bpl::ArgusExposureFusion::ArgusExposureFusion(const float sigma, const bool multiThreaded):
+    multiThreaded(multiThreaded) {
+
+    if (sigma <= 0.0f) throw std::string("The exposure fusion sigma must be positive");
+
+    for (auto i = 0; i < weightLookup.size(); i++)
+    {
+        const auto offset = (i / 255.0f) - 0.5f;
+        weightLookup[i] = std::exp(-(offset * offset) / (2.0f * sigma * sigma)) + 1.0e-6f;
+    }
+}
+
+void bpl::ArgusExposureFusion::merge(const ArgusVideoCapture::BurstGroup& burst, cv::Mat& merged) const
+{
+    auto exposures = std::vector<cv::Mat>();
+    for (const auto& frame : burst.frames) exposures.push_back(frame.image);
+
+    merge(exposures, merged);
+}
+
+// note, the exposures must all be the same size and either CV_8UC4 (BGRA) or CV_8UC1, the merged output has the same type
+//
+void bpl::ArgusExposureFusion::merge(const std::vector<cv::Mat>& exposures, cv::Mat& merged) const
+{
+    if (exposures.empty()) throw std::string("Unable to merge, no exposures have been supplied");
+    if (exposures.size() > ArgusVideoCapture::MAX_BURST_LENGTH) throw std::string("Unable to merge, too many exposures have been supplied");
+
+    const auto type = exposures[0].type();
+    const auto size = exposures[0].size();
+    if ((type != CV_8UC4) && (type != CV_8UC1)) throw std::string("Unable to merge, the exposures must be CV_8UC4 or CV_8UC1");
+    for (const auto& exposure : exposures)
+    {
+        if ((exposure.type() != type) || (exposure.size() != size)) throw std::string("Unable to merge, the exposures must all have the same size and type");
+    }
+
+    merged.create(size, type);
+    if (multiThreaded) cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& rows) { mergeRows(exposures, merged, rows); });
+    else mergeRows(exposures, merged, cv::Range(0, size.height));
+}
+
+//
+// private methods
+//
+
+// note, for CV_8UC4 the luma is approximated using the BT.601 weights applied to the B, G and R bytes, the merged alpha is opaque
+//
+void bpl::ArgusExposureFusion::mergeRows(const std::vector<cv::Mat>& exposures, cv::Mat& merged, const cv::Range& rows) const
+{
+    const auto count = int32_t(exposures.size());
+    const auto channels = merged.channels();
+    const auto width = merged.cols;
+
+    const uint8_t* sources[ArgusVideoCapture::MAX_BURST_LENGTH];
+    for (auto row = rows.start; row < rows.end; row++)
+    {
+        for (auto i = 0; i < count; i++) sources[i] = exposures[i].ptr<uint8_t>(row);
+        auto* destination = merged.ptr<uint8_t>(row);
+
+        if (channels == 1)
+        {
+            for (auto x = 0; x < width; x++)
+            {
+                auto weightSum = 0.0f, valueSum = 0.0f;
+                for (auto i = 0; i < count; i++)
+                {
+                    const auto value = sources[i][x];
+                    const auto weight = weightLookup[value];
+                    weightSum += weight;
+                    valueSum += weight * value;
+                }
+
+                destination[x] = cv::saturate_cast<uint8_t>(valueSum / weightSum);
+            }
+        }
+        else
+        {
+            for (auto x = 0; x < width; x++)
+            {
+                auto weightSum = 0.0f, blueSum = 0.0f, greenSum = 0.0f, redSum = 0.0f;
+                for (auto i = 0; i < count; i++)
+                {
+                    const auto* pixel = sources[i] + (x * 4);
+                    const auto luma = ((29 * pixel[0]) + (150 * pixel[1]) + (77 * pixel[2])) >> 8;
+                    const auto weight = weightLookup[luma];
+                    weightSum += weight;
+                    blueSum += weight * pixel[0];
+                    greenSum += weight * pixel[1];
+                    redSum += weight * pixel[2];
+                }
+
+                auto* pixel = destination + (x * 4);
+                pixel[0] = cv::saturate_cast<uint8_t>(blueSum / weightSum);
+                pixel[1] = cv::saturate_cast<uint8_t>(greenSum / weightSum);
+                pixel[2] = cv::saturate_cast<uint8_t>(redSum / weightSum);
+                pixel[3] = 255;
+            }
+        }
+    }
+}
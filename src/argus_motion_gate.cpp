@@ -0,0 +1,90 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include <string>
+
+#include "argus_motion_gate.hpp"
+
+bpl::ArgusMotionGate::ArgusMotionGate(const cv::Size2i& sampleSize, const cv::Size2i& gridSize, const double regionThreshold, const int32_t minChangedRegions):
+    sampleSize(sampleSize), gridSize(gridSize), regionThreshold(regionThreshold), minChangedRegions(minChangedRegions), changedRegionCount(0) {
+
+    if ((sampleSize.width <= 0) || (sampleSize.height <= 0)) throw std::string("The motion gate sample size must be positive");
+    if ((gridSize.width <= 0) || (gridSize.height <= 0)) throw std::string("The motion gate grid size must be positive");
+    if ((gridSize.width > sampleSize.width) || (gridSize.height > sampleSize.height)) throw std::string("The motion gate grid size must not exceed the sample size");
+    if (minChangedRegions < 1) throw std::string("The motion gate minimum number of changed regions must be at least 1");
+}
+
+// note, the subsampled luma plane is scaled by the hardware during the conversion, the full resolution frame is not touched
+//
+bool bpl::ArgusMotionGate::hasChanged(ArgusVideoCapture& capture)
+{
+    return hasChanged(capture.retrieve(ArgusVideoCapture::PIXEL_FORMAT_GREY, sampleSize));
+}
+
+// notes 1, the first frame after construction or reset() is always reported as a change and becomes the reference
+//       2, all of the working cv::Mat instances are reused, so nothing is allocated once the first frame has been processed
+//
+bool bpl::ArgusMotionGate::hasChanged(const cv::Mat& luma)
+{
+    if ((luma.type() != CV_8UC1) || (luma.size() != sampleSize)) throw std::string("The motion gate expects a CV_8UC1 luma plane matching the sample size");
+
+    if (reference.empty())
+    {
+        luma.copyTo(reference);
+        regionDifferences.create(gridSize, CV_8UC1);
+        regionDifferences.setTo(cv::Scalar(255));
+        changeMask.create(gridSize, CV_8UC1);
+        changeMask.setTo(cv::Scalar(255));
+        changedRegionCount = gridSize.area();
+
+        return true;
+    }
+
+    // the area interpolation averages the absolute differences over each grid region
+    //
+    cv::absdiff(luma, reference, difference);
+    cv::resize(difference, regionDifferences, gridSize, 0, 0, cv::INTER_AREA);
+    cv::compare(regionDifferences, cv::Scalar(regionThreshold), changeMask, cv::CMP_GT);
+    changedRegionCount = cv::countNonZero(changeMask);
+
+    if (changedRegionCount < minChangedRegions) return false;
+
+    luma.copyTo(reference);
+    return true;
+}
+
+void bpl::ArgusMotionGate::reset()
+{
+    reference.release();
+    changedRegionCount = 0;
+}
+
+cv::Size2i bpl::ArgusMotionGate::getSampleSize() const
+{
+    return sampleSize;
+}
+
+cv::Size2i bpl::ArgusMotionGate::getGridSize() const
+{
+    return gridSize;
+}
+
+// note, a gridSize CV_8UC1 mask, set to 255 for each region that exceeded the threshold
+//
+const cv::Mat& bpl::ArgusMotionGate::getChangeMask() const
+{
+    return changeMask;
+}
+
+// note, a gridSize CV_8UC1 matrix containing the mean absolute luma difference of each region
+//
+const cv::Mat& bpl::ArgusMotionGate::getRegionDifferences() const
+{
+    return regionDifferences;
+}
+
+int32_t bpl::ArgusMotionGate::getChangedRegionCount() const
+{
+    return changedRegionCount;
+}
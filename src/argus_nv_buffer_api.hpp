@@ -0,0 +1,149 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#ifndef BIT_PARALLEL_ARGUS_NV_BUFFER_API_HPP
+#define BIT_PARALLEL_ARGUS_NV_BUFFER_API_HPP
+
+#include <cstdint>
+
+#include <Argus/Argus.h>
+#include <EGLStream/NV/ImageNativeBuffer.h>
+
+// deal with NvBuffer and NvBufSurface difference between JetPack v4 and v5 respectively
+// env JETPACK_4_DETECTED or JETPACK_5_OR_GREATER_DETECTED is determined and passed in by CMake
+//
+#ifdef JETPACK_5_OR_GREATER_DETECTED
+#include "nvbuf_utils.h"
+#include "nvbufsurftransform.h"
+#endif
+
+#include "argus_opencv_video_capture.hpp"
+
+//
+// notes 1, a traits layer for the JetPack DMA buffer API, NvBuffer for JetPack 4 and NvBufSurface for JetPack 5 or greater
+//       2, only the specialisation matching the JetPack version being built is defined, use NvBufferApi as selected below
+//       3, colourFormat() is constexpr so that the typed capture front end resolves its buffer format at compile time
+//       4, this header relies on the PRIVATE CMake JetPack definitions, so it lives alongside the implementation and is not installed
+//       5, the NvBuffer ARGB32 and ABGR32 formats are stored as B, G, R, A and R, G, B, A bytes respectively
+//       6, transform() crops the region from the source buffer and scales and converts it into the destination buffer using the
+//          hardware, the region is in source pixel coordinates
+//
+
+namespace bpl
+{
+    template<int32_t JetPackMajorVersion>
+    struct NvBufferApiTraits;
+
+#ifdef JETPACK_4_DETECTED
+    template<>
+    struct NvBufferApiTraits<4>
+    {
+        using ColourFormat = NvBufferColorFormat;
+
+        static constexpr ColourFormat colourFormat(const int32_t pixelFormat)
+        {
+            switch (pixelFormat)
+            {
+                case ArgusVideoCapture::PIXEL_FORMAT_BGRA: return NvBufferColorFormat_ARGB32;
+                case ArgusVideoCapture::PIXEL_FORMAT_RGBA: return NvBufferColorFormat_ABGR32;
+                case ArgusVideoCapture::PIXEL_FORMAT_GREY: return NvBufferColorFormat_GRAY8;
+                default: return NvBufferColorFormat_Invalid;
+            }
+        }
+
+        static constexpr bool isValid(const ColourFormat colourFormat)
+        {
+            return colourFormat != NvBufferColorFormat_Invalid;
+        }
+
+        static constexpr ColourFormat nativeColourFormat()
+        {
+            return NvBufferColorFormat_YUV420;
+        }
+
+        static int32_t create(EGLStream::NV::IImageNativeBuffer* iImageNativeBuffer, const Argus::Size2D<uint32_t>& size, const ColourFormat colourFormat)
+        {
+            return iImageNativeBuffer->createNvBuffer(size, colourFormat, NvBufferLayout_Pitch);
+        }
+
+        static uint32_t getPitch(const int32_t dmaBufferFd)
+        {
+            auto dmaBufferParams = NvBufferParams();
+            NvBufferGetParams(dmaBufferFd, &dmaBufferParams);
+            return dmaBufferParams.pitch[0];
+        }
+
+        static bool transform(const int32_t sourceFd, const int32_t destinationFd, const cv::Rect& region)
+        {
+            auto params = NvBufferTransformParams();
+            params.transform_flag = NVBUFFER_TRANSFORM_FILTER | NVBUFFER_TRANSFORM_CROP_SRC;
+            params.transform_filter = NvBufferTransform_Filter_Smart;
+            params.src_rect = NvBufferRect{uint32_t(region.y), uint32_t(region.x), uint32_t(region.width), uint32_t(region.height)};
+
+            return NvBufferTransform(sourceFd, destinationFd, &params) == 0;
+        }
+    };
+
+    using NvBufferApi = NvBufferApiTraits<4>;
+#else
+    template<>
+    struct NvBufferApiTraits<5>
+    {
+        using ColourFormat = NvBufSurfaceColorFormat;
+
+        static constexpr ColourFormat colourFormat(const int32_t pixelFormat)
+        {
+            switch (pixelFormat)
+            {
+                case ArgusVideoCapture::PIXEL_FORMAT_BGRA: return NVBUF_COLOR_FORMAT_ARGB;
+                case ArgusVideoCapture::PIXEL_FORMAT_RGBA: return NVBUF_COLOR_FORMAT_ABGR;
+                case ArgusVideoCapture::PIXEL_FORMAT_GREY: return NVBUF_COLOR_FORMAT_GRAY8;
+                default: return NVBUF_COLOR_FORMAT_INVALID;
+            }
+        }
+
+        static constexpr bool isValid(const ColourFormat colourFormat)
+        {
+            return colourFormat != NVBUF_COLOR_FORMAT_INVALID;
+        }
+
+        static constexpr ColourFormat nativeColourFormat()
+        {
+            return NVBUF_COLOR_FORMAT_YUV420;
+        }
+
+        static int32_t create(EGLStream::NV::IImageNativeBuffer* iImageNativeBuffer, const Argus::Size2D<uint32_t>& size, const ColourFormat colourFormat)
+        {
+            return iImageNativeBuffer->createNvBuffer(size, colourFormat, NVBUF_LAYOUT_PITCH);
+        }
+
+        static uint32_t getPitch(const int32_t dmaBufferFd)
+        {
+            NvBufSurface* surface = nullptr;
+            NvBufSurfaceFromFd(dmaBufferFd, reinterpret_cast<void**>(&surface));
+            return surface->surfaceList[0].pitch;
+        }
+
+        static bool transform(const int32_t sourceFd, const int32_t destinationFd, const cv::Rect& region)
+        {
+            NvBufSurface* source = nullptr;
+            NvBufSurface* destination = nullptr;
+            if (NvBufSurfaceFromFd(sourceFd, reinterpret_cast<void**>(&source)) != 0) return false;
+            if (NvBufSurfaceFromFd(destinationFd, reinterpret_cast<void**>(&destination)) != 0) return false;
+
+            auto sourceRect = NvBufSurfTransformRect{uint32_t(region.y), uint32_t(region.x), uint32_t(region.width), uint32_t(region.height)};
+            auto params = NvBufSurfTransformParams();
+            params.transform_flag = NVBUFSURF_TRANSFORM_FILTER | NVBUFSURF_TRANSFORM_CROP_SRC;
+            params.transform_filter = NvBufSurfTransformInter_Default;
+            params.src_rect = &sourceRect;
+
+            return NvBufSurfTransform(source, destination, &params) == NvBufSurfTransformError_Success;
+        }
+    };
+
+    using NvBufferApi = NvBufferApiTraits<5>;
+#endif
+}
+
+#endif
@@ -2,21 +2,21 @@
 // (c) Bit Parallel Ltd, July 2023
 //
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
-// deal with NvBuffer and NvBufSurface difference between JetPack v4 and v5 respectively
-// env JETPACK_5_OR_GREATER_DETECTED is determined and passed in by CMake
-//
-#ifdef JETPACK_5_OR_GREATER_DETECTED
-#include "nvbuf_utils.h"
-#endif
-
+#include "argus_nv_buffer_api.hpp"
 #include "argus_opencv_video_capture.hpp"
 
+// note, indexed using the ArgusVideoCapture::PIXEL_FORMAT_XXX constants, the ordering must be maintained
+//
+static const int32_t cvPixelTypes[] = {CV_8UC4, CV_8UC4, CV_8UC1};
+
 bpl::ArgusVideoCapture::ArgusVideoCapture(const int32_t cameraDeviceIndex, const int32_t sensorModeIndex):
     cameraDeviceIndex(cameraDeviceIndex), sensorModeIndex(sensorModeIndex), argusCameraSettings(ArgusCameraSettings(iSourceSettings, iAutoControlSettings)),
-    dmaBufferFd(0), cvImageBuffer(nullptr), image(nullptr), timestamp(uint64_t(0)) {
+    image(nullptr), iNativeBuffer(nullptr), convertedImages(), nativeImage{-1, {0, 0}, 0, 0, 0, nullptr, 0, 0}, leasedImages(), iBurstFrameConsumer(nullptr), burstImages(MAX_BURST_LENGTH, ConvertedImage{-1, {0, 0}, 0, 0, 0, nullptr, 0, 0}),
+    frameCount(uint64_t(0)), captureId(uint32_t(0)), timestamp(uint64_t(0)) {
 
     // set up the Argus API framework
     //
@@ -118,21 +118,27 @@ bpl::ArgusVideoCapture::~ArgusVideoCapture()
     iSession->stopRepeat();
     iSession->waitForIdle();
 
-    if (dmaBufferFd)
-    {
-        NvBufferMemUnMap(dmaBufferFd, 0, &cvImageBuffer);
-        NvBufferDestroy(dmaBufferFd);
-    }
+    for (auto& converted : convertedImages) release(converted);
+    release(nativeImage);
+    for (auto& converted : leasedImages) release(*converted);
+    for (auto& converted : burstImages) release(converted);
+    burstRequests.clear();
+    burstConsumer.reset();
+    burstStream.reset();
 
     cameraProvider.reset();
 }
 
-cv::Mat bpl::ArgusVideoCapture::grab()
+// notes 1, acquires the captured camera frame and its metadata only, no pixel format conversion or CPU mapping takes place
+//       2, this makes it cheap to discard frames, i.e. after inspecting getTimestamp() or getCaptureId()
+//
+void bpl::ArgusVideoCapture::grab()
 {
     // notes 1, acquire a captured camera frame, using mailbox mode
     //       2, frame and iFrame are retained as instance properties as they are required by image as used in saveAsJPEG()
     //
     auto status = Argus::STATUS_OK;
+    iNativeBuffer = nullptr;
     frame = Argus::UniqueObj<EGLStream::Frame>(iFrameConsumer->acquireFrame(FIVE_SECONDS_IN_NANOSECONDS, &status));
     if (status != Argus::STATUS_OK) throw std::string("Failed to aquire a camera frame from the EGLStream::IFrameConsumer instance");
 
@@ -144,30 +150,148 @@ cv::Mat bpl::ArgusVideoCapture::grab()
     image = iFrame->getImage();
     if (!image) throw std::string("Failed to get an image from the EGLStream::IFrame instance");
 
-    auto* iNativeBuffer = Argus::interface_cast<EGLStream::NV::IImageNativeBuffer>(image);
+    iNativeBuffer = Argus::interface_cast<EGLStream::NV::IImageNativeBuffer>(image);
     if (!iNativeBuffer) throw std::string("IImageNativeBuffer not supported for image type");
 
-    if (dmaBufferFd)
+    frameCount++;
+}
+
+cv::Mat bpl::ArgusVideoCapture::retrieve(const int32_t format)
+{
+    return retrieve(format, getResolution());
+}
+
+// notes 1, the conversion, CPU mapping and cache sync only take place on the first request for each format and size per grabbed frame
+//       2, the DMA buffer for each format and size is created and mapped once and is then reused, so the returned cv::Mat is only valid
+//          until the next call to retrieve() for the same format and size after a subsequent grab(), clone() it if required
+//       3, when the size differs from the sensor resolution the scaling is performed by the hardware during the conversion, so requesting
+//          a small PIXEL_FORMAT_GREY image provides a cheap subsampled luma plane, e.g. for use with the ArgusMotionGate class
+//
+cv::Mat bpl::ArgusVideoCapture::retrieve(const int32_t format, const cv::Size2i& size)
+{
+    if ((format < PIXEL_FORMAT_BGRA) || (format > PIXEL_FORMAT_GREY)) throw std::string("Unsupported pixel format: " + std::to_string(format));
+
+    return retrieveConverted(format, NvBufferApi::colourFormat(format), cvPixelTypes[format], size);
+}
+
+// notes 1, crops the region from the frame and scales it to the requested size, the crop, scaling and conversion are performed by
+//          the hardware from a native YUV 4:2:0 copy of the frame, so the CPU only maps and reads the pixels of the region
+//       2, the native copy is made once per grabbed frame and is shared by all of the regions retrieved from that frame
+//       3, the DMA buffers are pooled per format and size, a buffer that was not used for the current frame is reused for a new
+//          region, so moving regions do not allocate, the returned cv::Mat has the same lifetime as for retrieve(format, size)
+//
+cv::Mat bpl::ArgusVideoCapture::retrieve(const int32_t format, const cv::Size2i& size, const cv::Rect& region)
+{
+    if (!iNativeBuffer) throw std::string("Unable to retrieve the captured frame, grab() has not been called");
+    if ((format < PIXEL_FORMAT_BGRA) || (format > PIXEL_FORMAT_GREY)) throw std::string("Unsupported pixel format: " + std::to_string(format));
+    if ((size.width <= 0) || (size.height <= 0)) throw std::string("Unsupported retrieve() size, the width and height must be positive");
+
+    const auto frameBounds = cv::Rect(0, 0, resolution.width(), resolution.height());
+    if ((region.area() <= 0) || ((region & frameBounds) != region)) throw std::string("The retrieve() region lies outside of the frame");
+
+    const auto bufferSize = Argus::Size2D<uint32_t>(size.width, size.height);
+    auto converted = std::find_if(convertedImages.begin(), convertedImages.end(), [&](const ConvertedImage& candidate) {
+        return (candidate.format == format) && (candidate.size == bufferSize) && (candidate.region == region);
+    });
+
+    if (converted == convertedImages.end())
     {
-        NvBufferMemUnMap(dmaBufferFd, 0, &cvImageBuffer);
-        NvBufferDestroy(dmaBufferFd);
+        converted = std::find_if(convertedImages.begin(), convertedImages.end(), [&](const ConvertedImage& candidate) {
+            return (candidate.format == format) && (candidate.size == bufferSize) && (candidate.region.area() > 0) && (candidate.frameCount != frameCount);
+        });
+
+        if (converted != convertedImages.end())
+        {
+            converted->region = region;
+            converted->frameCount = 0;
+        }
+        else
+        {
+            converted = convertedImages.insert(converted, ConvertedImage{format, bufferSize, NvBufferApi::colourFormat(format), cvPixelTypes[format], 0, nullptr, 0, 0, region});
+        }
     }
 
-    // deal with NvBuffer and NvBufSurface difference between JetPack v4 and v5 respectively
-    // env JETPACK_4_DETECTED is determined and passed in by CMake
-    //
-#ifdef JETPACK_4_DETECTED
-    dmaBufferFd = iNativeBuffer->createNvBuffer(resolution, NvBufferColorFormat_ARGB32, NvBufferLayout_Pitch);
-#else
-    dmaBufferFd = iNativeBuffer->createNvBuffer(resolution, NVBUF_COLOR_FORMAT_ARGB, NVBUF_LAYOUT_PITCH);
-#endif
-//  auto dmaBufferParams = NvBufferParams();
-//  NvBufferGetParams(dmaBufferFd, &dmaBufferParams);
-//  std::cout << "**** Pitch: " << dmaBufferParams.pitch[0] << ", Offset: " << dmaBufferParams.offset[0] << "\n";
+    if (converted->frameCount != frameCount)
+    {
+        if (nativeImage.frameCount != frameCount)
+        {
+            if (nativeImage.dmaBufferFd > 0)
+            {
+                const auto status = iNativeBuffer->copyToNvBuffer(nativeImage.dmaBufferFd);
+                if (status != Argus::STATUS_OK) throw std::string("Failed to copy the captured frame into the native NvBuffer");
+            }
+            else
+            {
+                nativeImage.dmaBufferFd = NvBufferApi::create(iNativeBuffer, resolution, NvBufferApi::nativeColourFormat());
+                if (nativeImage.dmaBufferFd < 0) throw std::string("Failed to create a native DMA buffer for the captured frame");
+            }
+
+            nativeImage.frameCount = frameCount;
+        }
+
+        convert(iNativeBuffer, *converted);
+        converted->frameCount = frameCount;
+    }
 
-    NvBufferMemMap(dmaBufferFd, 0, NvBufferMem_Read_Write, &cvImageBuffer);
-    NvBufferMemSyncForCpu(dmaBufferFd, 0, &cvImageBuffer);
-    return cv::Mat(resolution.height(), resolution.width(), CV_8UC4, cvImageBuffer);
+    return cv::Mat(size.height, size.width, converted->cvType, converted->buffer, converted->pitch);
+}
+
+// note, equivalent to cv::VideoCapture::read(), i.e. grab() followed by retrieve()
+//
+cv::Mat bpl::ArgusVideoCapture::read(const int32_t format)
+{
+    grab();
+    return retrieve(format);
+}
+
+// notes 1, as retrieve(), but the frame is converted into one of a small pool of DMA buffers per format and size, and the returned
+//          lease prevents that buffer from being reused, so the image remains valid for as long as the lease is held
+//       2, a buffer is reused once all of its leases have been released, further retrieves of the same grabbed frame share its buffer
+//       3, throws if all MAX_LEASED_BUFFERS for the format and size are leased, i.e. the caller is retaining too many frames
+//       4, used by the python bindings, where each numpy array holds the lease of the frame that it views
+//
+bpl::ArgusVideoCapture::LeasedImage bpl::ArgusVideoCapture::retrieveLeased(const int32_t format, const cv::Size2i& size)
+{
+    if (!iNativeBuffer) throw std::string("Unable to retrieve the captured frame, grab() has not been called");
+    if ((format < PIXEL_FORMAT_BGRA) || (format > PIXEL_FORMAT_GREY)) throw std::string("Unsupported pixel format: " + std::to_string(format));
+    if ((size.width <= 0) || (size.height <= 0)) throw std::string("Unsupported retrieve() size, the width and height must be positive");
+
+    const auto bufferSize = Argus::Size2D<uint32_t>(size.width, size.height);
+    auto leased = std::shared_ptr<ConvertedImage>();
+    auto bufferCount = int32_t(0);
+    for (const auto& candidate : leasedImages)
+    {
+        if ((candidate->format != format) || !(candidate->size == bufferSize)) continue;
+        if (candidate->frameCount == frameCount)
+        {
+            leased = candidate;
+            break;
+        }
+
+        // note, the pool holds one reference, so a use count of 1 means that no leases are outstanding
+        //
+        if (!leased && (candidate.use_count() == 1)) leased = candidate;
+        bufferCount++;
+    }
+
+    if (!leased)
+    {
+        if (bufferCount >= MAX_LEASED_BUFFERS)
+        {
+            throw std::string("All " + std::to_string(MAX_LEASED_BUFFERS) + " leased buffers for the requested format and size are in use, release or copy the retained frames");
+        }
+
+        leased = std::make_shared<ConvertedImage>(ConvertedImage{format, bufferSize, NvBufferApi::colourFormat(format), cvPixelTypes[format], 0, nullptr, 0, 0});
+        leasedImages.push_back(leased);
+    }
+
+    if (leased->frameCount != frameCount)
+    {
+        convert(iNativeBuffer, *leased);
+        leased->frameCount = frameCount;
+    }
+
+    return LeasedImage{cv::Mat(size.height, size.width, leased->cvType, leased->buffer, leased->pitch), leased, captureId, timestamp};
 }
 
 cv::Size2i bpl::ArgusVideoCapture::getResolution() const
@@ -229,3 +353,268 @@ bool bpl::ArgusVideoCapture::restart()
 
     return success;
 }
+
+// notes 1, pre-builds an additional capture request for use by captureBurst(), the returned settings apply only to this request
+//       2, e.g. use setExposureTime() and setGain() on each request to build an exposure bracket
+//       3, the burst requests output to a dedicated FIFO mode stream so that none of the burst frames are dropped
+//       4, the auto exposure is locked and the ISP digital gain is fixed at 1.0 on each request, otherwise the ISP can raise the
+//          digital gain of the short exposures and flatten the bracket, use setAutoExposureLock(false) to re-enable auto exposure
+//
+bpl::ArgusCameraSettings& bpl::ArgusVideoCapture::addBurstRequest()
+{
+    if (burstRequests.size() >= MAX_BURST_LENGTH) throw std::string("Unable to add a burst request, the maximum burst length is " + std::to_string(MAX_BURST_LENGTH));
+    if (!burstStream) createBurstStream();
+
+    auto burstRequest = std::make_unique<BurstRequest>();
+    burstRequest->request = Argus::UniqueObj<Argus::Request>(iSession->createRequest(Argus::CAPTURE_INTENT_STILL_CAPTURE));
+    auto* iRequest = Argus::interface_cast<Argus::IRequest>(burstRequest->request);
+    if (!iRequest) throw std::string("Failed to get the burst capture Argus::IRequest interface");
+
+    const auto status = iRequest->enableOutputStream(burstStream.get());
+    if (status != Argus::STATUS_OK) throw std::string("Failed to enable the burst capture request stream");
+
+    burstRequest->iSourceSettings = Argus::interface_cast<Argus::ISourceSettings>(burstRequest->request);
+    if (!burstRequest->iSourceSettings) throw std::string("Failed to get the burst request Argus::ISourceSettings interface");
+    burstRequest->iSourceSettings->setSensorMode(sensorModes[sensorModeIndex]);
+
+    burstRequest->iAutoControlSettings = Argus::interface_cast<Argus::IAutoControlSettings>(iRequest->getAutoControlSettings());
+    if (!burstRequest->iAutoControlSettings) throw std::string("Failed to get the burst request Argus::IAutoControlSettings interface");
+
+    if (burstRequest->iAutoControlSettings->setIspDigitalGainRange(Argus::Range<float>(1.0f)) != Argus::STATUS_OK)
+    {
+        throw std::string("Failed to fix the burst request ISP digital gain range");
+    }
+
+    if (burstRequest->iAutoControlSettings->setAeLock(true) != Argus::STATUS_OK) throw std::string("Failed to lock the burst request auto exposure");
+
+    burstRequests.push_back(std::move(burstRequest));
+    return burstRequests.back()->settings;
+}
+
+void bpl::ArgusVideoCapture::clearBurstRequests()
+{
+    burstRequests.clear();
+}
+
+int32_t bpl::ArgusVideoCapture::getBurstLength() const
+{
+    return int32_t(burstRequests.size());
+}
+
+// notes 1, pauses the repeating capture request, submits all of the burst requests as a single burst and then resumes repeating
+//       2, the frames are returned in request order along with the exposure time and gains that were actually applied by the sensor
+//       3, each burst frame is converted into its own reusable DMA buffer, so the images are valid until the next captureBurst()
+//       4, any frames left in the FIFO by an earlier failed burst are drained before submitting, and each frame's capture id is
+//          checked against the burst id, so a stale frame can never be returned as part of a later burst
+//
+bpl::ArgusVideoCapture::BurstGroup bpl::ArgusVideoCapture::captureBurst(const int32_t format)
+{
+    if (burstRequests.empty()) throw std::string("Unable to capture a burst, no burst requests have been added");
+    if ((format < PIXEL_FORMAT_BGRA) || (format > PIXEL_FORMAT_GREY)) throw std::string("Unsupported pixel format: " + std::to_string(format));
+
+    iSession->stopRepeat();
+    auto status = iSession->waitForIdle(ONE_SECOND_IN_NANOSECONDS);
+    if (status != Argus::STATUS_OK)
+    {
+        iSession->repeat(request.get());
+        throw std::string("Timeout whilst waiting for the repeating capture requests to stop");
+    }
+
+    auto group = BurstGroup();
+    try
+    {
+        auto requests = std::vector<const Argus::Request*>();
+        for (const auto& burstRequest : burstRequests) requests.push_back(burstRequest->request.get());
+
+        // note, the session is idle, so any frames from an earlier burst have already been delivered to the FIFO
+        //
+        while (true)
+        {
+            auto staleFrame = Argus::UniqueObj<EGLStream::Frame>(iBurstFrameConsumer->acquireFrame(0, &status));
+            if ((status != Argus::STATUS_OK) || !staleFrame) break;
+        }
+
+        group.burstId = iSession->captureBurst(requests, Argus::TIMEOUT_INFINITE, &status);
+        if ((status != Argus::STATUS_OK) || (group.burstId == 0)) throw std::string("Failed to submit the burst capture requests");
+
+        auto discarded = int32_t(0);
+        while (group.frames.size() < requests.size())
+        {
+            const auto i = group.frames.size();
+            auto burstFrame = Argus::UniqueObj<EGLStream::Frame>(iBurstFrameConsumer->acquireFrame(FIVE_SECONDS_IN_NANOSECONDS, &status));
+            if (status != Argus::STATUS_OK) throw std::string("Failed to aquire a burst frame from the EGLStream::IFrameConsumer instance");
+
+            auto* iBurstFrame = Argus::interface_cast<EGLStream::IFrame>(burstFrame);
+            if (!iBurstFrame) throw std::string("Failed to get the burst frame EGLStream::IFrame interface");
+
+            auto* iArgusCaptureMetadata = Argus::interface_cast<EGLStream::IArgusCaptureMetadata>(burstFrame);
+            if (!iArgusCaptureMetadata) throw std::string("Failed to get the burst frame EGLStream::IArgusCaptureMetadata interface");
+
+            const auto* iCaptureMetadata = Argus::interface_cast<const Argus::ICaptureMetadata>(iArgusCaptureMetadata->getMetadata());
+            if (!iCaptureMetadata) throw std::string("Failed to get the burst frame Argus::ICaptureMetadata interface");
+
+            // note, the burst requests are assigned consecutive capture ids starting from the burst id
+            //
+            const auto burstCaptureId = iCaptureMetadata->getCaptureId();
+            if (burstCaptureId < group.burstId)
+            {
+                if (++discarded > MAX_BURST_LENGTH) throw std::string("Too many stale frames were received whilst capturing the burst");
+                continue;
+            }
+
+            if (burstCaptureId != (group.burstId + i)) throw std::string("A burst frame is missing, expected capture id " + std::to_string(group.burstId + i) + " but received " + std::to_string(burstCaptureId));
+
+            auto* burstImage = iBurstFrame->getImage();
+            auto* iBurstNativeBuffer = Argus::interface_cast<EGLStream::NV::IImageNativeBuffer>(burstImage);
+            if (!iBurstNativeBuffer) throw std::string("IImageNativeBuffer not supported for burst image type");
+
+            auto& converted = burstImages[i];
+            if (converted.format != format)
+            {
+                release(converted);
+                converted.format = format;
+                converted.size = resolution;
+                converted.colourFormat = NvBufferApi::colourFormat(format);
+                converted.cvType = cvPixelTypes[format];
+            }
+
+            convert(iBurstNativeBuffer, converted);
+
+            auto captured = BurstFrame();
+            captured.image = cv::Mat(resolution.height(), resolution.width(), converted.cvType, converted.buffer, converted.pitch);
+            captured.captureId = iBurstFrame->getNumber();
+            captured.timestamp = iBurstFrame->getTime();
+            captured.exposureTime = iCaptureMetadata->getSensorExposureTime();
+            captured.analogGain = iCaptureMetadata->getSensorAnalogGain();
+            captured.ispDigitalGain = iCaptureMetadata->getIspDigitalGain();
+            group.frames.push_back(captured);
+        }
+    }
+    catch (...)
+    {
+        iSession->repeat(request.get());
+        throw;
+    }
+
+    status = iSession->repeat(request.get());
+    if (status != Argus::STATUS_OK) throw std::string("Failed to trigger repeating capture requests");
+
+    return group;
+}
+
+//
+// protected methods
+//
+
+// notes 1, the common implementation of retrieve(), the format is only used as a cache key, colourFormat and cvType describe the conversion
+//       2, used directly by the ArgusTypedVideoCapture front end, which resolves the colourFormat and cvType at compile time
+//
+cv::Mat bpl::ArgusVideoCapture::retrieveConverted(const int32_t format, const int32_t colourFormat, const int32_t cvType, const cv::Size2i& size)
+{
+    if (!iNativeBuffer) throw std::string("Unable to retrieve the captured frame, grab() has not been called");
+    if ((size.width <= 0) || (size.height <= 0)) throw std::string("Unsupported retrieve() size, the width and height must be positive");
+
+    const auto bufferSize = Argus::Size2D<uint32_t>(size.width, size.height);
+    auto converted = std::find_if(convertedImages.begin(), convertedImages.end(), [&](const ConvertedImage& candidate) {
+        return (candidate.format == format) && (candidate.size == bufferSize) && (candidate.region.area() == 0);
+    });
+
+    if (converted == convertedImages.end())
+    {
+        converted = convertedImages.insert(converted, ConvertedImage{format, bufferSize, colourFormat, cvType, 0, nullptr, 0, 0});
+    }
+
+    if (converted->frameCount != frameCount)
+    {
+        convert(iNativeBuffer, *converted);
+        converted->frameCount = frameCount;
+    }
+
+    return cv::Mat(size.height, size.width, cvType, converted->buffer, converted->pitch);
+}
+
+//
+// private methods
+//
+
+// note, the session must be idle whilst the additional output stream is created
+//
+void bpl::ArgusVideoCapture::createBurstStream()
+{
+    iSession->stopRepeat();
+    auto status = iSession->waitForIdle(ONE_SECOND_IN_NANOSECONDS);
+    if (status != Argus::STATUS_OK) throw std::string("Timeout whilst waiting for the repeating capture requests to stop");
+
+    auto streamSettings = Argus::UniqueObj<Argus::OutputStreamSettings>(iSession->createOutputStreamSettings(Argus::STREAM_TYPE_EGL));
+    auto* iEGLStreamSettings = Argus::interface_cast<Argus::IEGLOutputStreamSettings>(streamSettings);
+    if (!iEGLStreamSettings) throw std::string("Cannot get the burst Argus::IEGLOutputStreamSettings interface");
+    iEGLStreamSettings->setPixelFormat(Argus::PIXEL_FMT_YCbCr_420_888);
+    iEGLStreamSettings->setResolution(resolution);
+    iEGLStreamSettings->setMetadataEnable(true);
+    iEGLStreamSettings->setMode(Argus::EGL_STREAM_MODE_FIFO);
+    iEGLStreamSettings->setFifoLength(MAX_BURST_LENGTH);
+
+    burstStream = Argus::UniqueObj<Argus::OutputStream>(iSession->createOutputStream(streamSettings.get()));
+    if (!burstStream) throw std::string("Failed to create the burst Argus::OutputStream instance");
+
+    burstConsumer = Argus::UniqueObj<EGLStream::FrameConsumer>(EGLStream::FrameConsumer::create(burstStream.get(), MAX_BURST_LENGTH));
+    iBurstFrameConsumer = Argus::interface_cast<EGLStream::IFrameConsumer>(burstConsumer);
+    if (!iBurstFrameConsumer) throw std::string("Failed to initialize the burst EGLStream::IFrameConsumer instance");
+
+    status = iSession->repeat(request.get());
+    if (status != Argus::STATUS_OK) throw std::string("Failed to trigger repeating capture requests");
+
+    const auto* iEglOutputStream = Argus::interface_cast<Argus::IEGLOutputStream>(burstStream);
+    status = iEglOutputStream->waitUntilConnected();
+    if (status != Argus::STATUS_OK) throw std::string("The burst Argus::OutputStream has failed to connect");
+}
+
+// notes 1, creates and maps the DMA buffer on first use, after which the image is copied into the existing buffer
+//       2, the hardware performs any pixel format conversion and scaling required by the buffer format and size
+//       3, the buffer is mapped read/write and may have been drawn on, e.g. cv::putText(), so the CPU cache is synced for the
+//          device before the buffer is reused, otherwise dirty cache lines could later be written back over the converted frame
+//       4, a region is cropped from the native copy of the frame, which must be current, on first use the buffer is created from
+//          the whole frame and is then overwritten by the crop
+//
+void bpl::ArgusVideoCapture::convert(EGLStream::NV::IImageNativeBuffer* iImageNativeBuffer, ConvertedImage& converted)
+{
+    const auto cropped = (converted.region.area() > 0);
+    if (converted.dmaBufferFd > 0)
+    {
+        NvBufferMemSyncForDevice(converted.dmaBufferFd, 0, &converted.buffer);
+        if (!cropped)
+        {
+            const auto status = iImageNativeBuffer->copyToNvBuffer(converted.dmaBufferFd);
+            if (status != Argus::STATUS_OK) throw std::string("Failed to copy the captured frame into the existing NvBuffer");
+        }
+    }
+    else
+    {
+        // note, the NvBuffer and NvBufSurface differences between JetPack v4 and v5 are dealt with by the NvBufferApi traits
+        //
+        converted.dmaBufferFd = NvBufferApi::create(iImageNativeBuffer, converted.size, NvBufferApi::ColourFormat(converted.colourFormat));
+        if (converted.dmaBufferFd < 0) throw std::string("Failed to create a DMA buffer for the captured frame");
+
+        converted.pitch = NvBufferApi::getPitch(converted.dmaBufferFd);
+        NvBufferMemMap(converted.dmaBufferFd, 0, NvBufferMem_Read_Write, &converted.buffer);
+    }
+
+    if (cropped && !NvBufferApi::transform(nativeImage.dmaBufferFd, converted.dmaBufferFd, converted.region))
+    {
+        throw std::string("Failed to crop the region of interest from the captured frame");
+    }
+
+    NvBufferMemSyncForCpu(converted.dmaBufferFd, 0, &converted.buffer);
+}
+
+void bpl::ArgusVideoCapture::release(ConvertedImage& converted)
+{
+    if (converted.dmaBufferFd > 0)
+    {
+        if (converted.buffer) NvBufferMemUnMap(converted.dmaBufferFd, 0, &converted.buffer);
+        NvBufferDestroy(converted.dmaBufferFd);
+    }
+
+    converted.dmaBufferFd = 0;
+    converted.buffer = nullptr;
+}
@@ -0,0 +1,155 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include <string>
+
+#include "argus_roi_extractor.hpp"
+
+// note, indexed using the ArgusRoiExtractor::OUTPUT_FORMAT_XXX constants, -1 indicates that no colour conversion is required
+//
+static const int32_t cvColourConversions[] = {-1, cv::COLOR_BGRA2BGR, cv::COLOR_BGRA2RGB, cv::COLOR_BGRA2GRAY};
+
+// note, the hardware output format for each of the ArgusRoiExtractor::OUTPUT_FORMAT_XXX constants and any CPU conversion that follows
+//
+static const int32_t hardwarePixelFormats[] = {
+    bpl::ArgusVideoCapture::PIXEL_FORMAT_BGRA, bpl::ArgusVideoCapture::PIXEL_FORMAT_BGRA, bpl::ArgusVideoCapture::PIXEL_FORMAT_RGBA, bpl::ArgusVideoCapture::PIXEL_FORMAT_GREY
+};
+static const int32_t hardwareColourConversions[] = {-1, cv::COLOR_BGRA2BGR, cv::COLOR_RGBA2RGB, -1};
+
+bpl::ArgusRoiExtractor::ArgusRoiExtractor(const bool multiThreaded):
+    multiThreaded(multiThreaded) {
+}
+
+// notes 1, the returned outputs are in the same order as the supplied regions
+//       2, the hardware transforms are issued in turn, only the CPU conversions to BGR and RGB are run in parallel
+//       3, the BGRA and GREY outputs are the mapped DMA buffers themselves, i.e. zero copy
+//
+const std::vector<cv::Mat>& bpl::ArgusRoiExtractor::extract(ArgusVideoCapture& capture, const std::vector<RegionOfInterest>& regions)
+{
+    validate(capture.getResolution(), regions);
+
+    outputs.resize(regions.size());
+    for (auto i = 0; i < regions.size(); i++)
+    {
+        const auto& roi = regions[i];
+        retrieved[i] = capture.retrieve(hardwarePixelFormats[roi.format], roi.size, roi.region);
+    }
+
+    const auto convertRegion = [&](const int32_t i) {
+        const auto conversion = hardwareColourConversions[regions[i].format];
+        if (conversion < 0)
+        {
+            outputs[i] = retrieved[i];
+        }
+        else
+        {
+            cv::cvtColor(retrieved[i], outputPool[i], conversion);
+            outputs[i] = outputPool[i];
+        }
+    };
+
+    if (multiThreaded && (regions.size() > 1))
+    {
+        cv::parallel_for_(cv::Range(0, int32_t(regions.size())), [&](const cv::Range& range) {
+            for (auto i = range.start; i < range.end; i++) convertRegion(i);
+        });
+    }
+    else
+    {
+        for (auto i = 0; i < regions.size(); i++) convertRegion(i);
+    }
+
+    return outputs;
+}
+
+// note, the returned outputs are in the same order as the supplied regions
+//
+const std::vector<cv::Mat>& bpl::ArgusRoiExtractor::extract(const cv::Mat& bgraFrame, const std::vector<RegionOfInterest>& regions)
+{
+    if (bgraFrame.type() != CV_8UC4) throw std::string("The region of interest extractor expects a CV_8UC4 BGRA frame");
+
+    validate(bgraFrame.size(), regions);
+
+    if (multiThreaded && (regions.size() > 1))
+    {
+        cv::parallel_for_(cv::Range(0, int32_t(regions.size())), [&](const cv::Range& range) {
+            for (auto i = range.start; i < range.end; i++) extractRegion(bgraFrame, regions[i], scratchPool[i], outputPool[i]);
+        });
+    }
+    else
+    {
+        for (auto i = 0; i < regions.size(); i++) extractRegion(bgraFrame, regions[i], scratchPool[i], outputPool[i]);
+    }
+
+    outputs.resize(regions.size());
+    for (auto i = 0; i < regions.size(); i++) outputs[i] = outputPool[i];
+
+    return outputs;
+}
+
+//
+// private methods
+//
+
+// note, also grows the pools, they only ever grow so the buffers are retained across calls with differing region counts
+//
+void bpl::ArgusRoiExtractor::validate(const cv::Size2i& frameSize, const std::vector<RegionOfInterest>& regions)
+{
+    const auto frameBounds = cv::Rect(0, 0, frameSize.width, frameSize.height);
+    for (const auto& roi : regions)
+    {
+        if ((roi.region.area() <= 0) || ((roi.region & frameBounds) != roi.region)) throw std::string("A region of interest lies outside of the frame");
+        if ((roi.size.width <= 0) || (roi.size.height <= 0)) throw std::string("A region of interest has an invalid target size");
+        if ((roi.format < OUTPUT_FORMAT_BGRA) || (roi.format > OUTPUT_FORMAT_GREY)) throw std::string("Unsupported region of interest format: " + std::to_string(roi.format));
+    }
+
+    if (outputPool.size() < regions.size())
+    {
+        outputPool.resize(regions.size());
+        scratchPool.resize(regions.size());
+        retrieved.resize(regions.size());
+    }
+}
+
+// notes 1, the source region is a view onto the frame, so no intermediate copy of the region is made
+//       2, when shrinking, the scaling is performed first so that the colour conversion runs on the smaller image
+//          when enlarging, the colour conversion is performed first for the same reason
+//       3, cv::Mat::create() is a no-op when the pooled buffer already has the required size and type
+//
+void bpl::ArgusRoiExtractor::extractRegion(const cv::Mat& bgraFrame, const RegionOfInterest& roi, cv::Mat& scratch, cv::Mat& output) const
+{
+    const auto source = bgraFrame(roi.region);
+    const auto conversion = cvColourConversions[roi.format];
+    const auto resizeRequired = (roi.size != roi.region.size());
+
+    if (!resizeRequired)
+    {
+        if (conversion < 0) source.copyTo(output);
+        else cv::cvtColor(source, output, conversion);
+    }
+    else if (roi.size.area() <= roi.region.area())
+    {
+        if (conversion < 0)
+        {
+            cv::resize(source, output, roi.size, 0, 0, cv::INTER_AREA);
+        }
+        else
+        {
+            cv::resize(source, scratch, roi.size, 0, 0, cv::INTER_AREA);
+            cv::cvtColor(scratch, output, conversion);
+        }
+    }
+    else
+    {
+        if (conversion < 0)
+        {
+            cv::resize(source, output, roi.size, 0, 0, cv::INTER_LINEAR);
+        }
+        else
+        {
+            cv::cvtColor(source, scratch, conversion);
+            cv::resize(scratch, output, roi.size, 0, 0, cv::INTER_LINEAR);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include "argus_nv_buffer_api.hpp"
+#include "argus_typed_video_capture.hpp"
+
+template<typename PixelFormat>
+bpl::ArgusTypedVideoCapture<PixelFormat>::ArgusTypedVideoCapture(const int32_t deviceIndex, const int32_t sensorModeIndex):
+    ArgusVideoCapture(deviceIndex, sensorModeIndex) {
+}
+
+template<typename PixelFormat>
+typename bpl::ArgusTypedVideoCapture<PixelFormat>::Frame bpl::ArgusTypedVideoCapture<PixelFormat>::retrieve()
+{
+    return retrieve(getResolution());
+}
+
+// note, see ArgusVideoCapture::retrieve() for the lifetime of the returned frame
+//
+template<typename PixelFormat>
+typename bpl::ArgusTypedVideoCapture<PixelFormat>::Frame bpl::ArgusTypedVideoCapture<PixelFormat>::retrieve(const cv::Size2i& size)
+{
+    constexpr auto colourFormat = NvBufferApi::colourFormat(PixelFormat::ID);
+    static_assert(NvBufferApi::isValid(colourFormat), "The pixel format is not supported by the NvBufferApi traits");
+
+    return Frame(retrieveConverted(PixelFormat::ID, colourFormat, cv::DataType<Pixel>::type, size));
+}
+
+template<typename PixelFormat>
+typename bpl::ArgusTypedVideoCapture<PixelFormat>::Frame bpl::ArgusTypedVideoCapture<PixelFormat>::read()
+{
+    grab();
+    return retrieve();
+}
+
+template class bpl::ArgusTypedVideoCapture<bpl::PixelFormatBGRA>;
+template class bpl::ArgusTypedVideoCapture<bpl::PixelFormatRGBA>;
+template class bpl::ArgusTypedVideoCapture<bpl::PixelFormatGrey>;
@@ -0,0 +1,101 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include <string>
+
+#include "argus_work_stealing_pool.hpp"
+
+bpl::ArgusWorkStealingPool::ArgusWorkStealingPool(const int32_t threadCount):
+    nextQueue(0), pendingTasks(0), running(true) {
+
+    if (threadCount < 1) throw std::string("The work stealing pool requires at least 1 thread");
+
+    for (auto i = 0; i < threadCount; i++) queues.push_back(std::make_unique<WorkQueue>());
+    for (auto i = 0; i < threadCount; i++) workers.emplace_back(&ArgusWorkStealingPool::run, this, i);
+}
+
+bpl::ArgusWorkStealingPool::~ArgusWorkStealingPool()
+{
+    {
+        const auto lock = std::lock_guard<std::mutex>(wakeMutex);
+        running = false;
+    }
+
+    wakeCondition.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void bpl::ArgusWorkStealingPool::submit(std::function<void()> task)
+{
+    auto& queue = *queues[nextQueue++ % queues.size()];
+    {
+        const auto lock = std::lock_guard<std::mutex>(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // note, the pending count is updated whilst holding the wake mutex so that a worker can't miss the notification
+    //
+    {
+        const auto lock = std::lock_guard<std::mutex>(wakeMutex);
+        pendingTasks++;
+    }
+
+    wakeCondition.notify_one();
+}
+
+int32_t bpl::ArgusWorkStealingPool::getThreadCount() const
+{
+    return int32_t(workers.size());
+}
+
+//
+// private methods
+//
+
+void bpl::ArgusWorkStealingPool::run(const int32_t index)
+{
+    auto task = std::function<void()>();
+    while (true)
+    {
+        if (takeTask(index, task))
+        {
+            pendingTasks--;
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        auto lock = std::unique_lock<std::mutex>(wakeMutex);
+        wakeCondition.wait(lock, [&] { return !running || (pendingTasks > 0); });
+        if (!running && (pendingTasks == 0)) return;
+    }
+}
+
+bool bpl::ArgusWorkStealingPool::takeTask(const int32_t index, std::function<void()>& task)
+{
+    auto& ownQueue = *queues[index];
+    {
+        const auto lock = std::lock_guard<std::mutex>(ownQueue.mutex);
+        if (!ownQueue.tasks.empty())
+        {
+            task = std::move(ownQueue.tasks.front());
+            ownQueue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (auto i = 1; i < queues.size(); i++)
+    {
+        auto& victimQueue = *queues[(index + i) % queues.size()];
+        const auto lock = std::lock_guard<std::mutex>(victimQueue.mutex);
+        if (!victimQueue.tasks.empty())
+        {
+            task = std::move(victimQueue.tasks.back());
+            victimQueue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
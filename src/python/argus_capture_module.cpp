@@ -0,0 +1,175 @@
+//
+// (c) Bit Parallel Ltd, October 2026
+//
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <opencv2/opencv.hpp>
+
+#include "argus_camera_settings.hpp"
+#include "argus_opencv_video_capture.hpp"
+
+namespace py = pybind11;
+
+//
+// notes 1, python bindings for the ArgusVideoCapture and ArgusCameraSettings classes
+//       2, retrieve() returns a Frame that exports the mapped DMA buffer using the buffer protocol, so numpy.asarray(frame)
+//          or frame.array are zero copy views, the numpy array keeps the Frame alive and the Frame keeps the capture alive
+//       3, each Frame holds a lease on its DMA buffer, see ArgusVideoCapture::retrieveLeased(), so its pixel data is not
+//          overwritten by later frames whilst the Frame or any array viewing it is alive, retaining more than
+//          ArgusVideoCapture::MAX_LEASED_BUFFERS frames per format and size raises a RuntimeError, use numpy.copy() instead
+//       4, the GIL is released whilst blocked in grab(), retrieve(), read() and restart(), these are serialised per capture
+//          instance so that concurrent python threads cannot interleave a grab() with another thread's retrieve()
+//
+
+namespace
+{
+    using Frame = bpl::ArgusVideoCapture::LeasedImage;
+
+    // note, adds the lock used to serialise the capture methods, which are called with the GIL released
+    //
+    class VideoCapture : public bpl::ArgusVideoCapture
+    {
+        public:
+            std::mutex mutex;
+
+            VideoCapture(const int32_t deviceIndex, const int32_t sensorModeIndex): ArgusVideoCapture(deviceIndex, sensorModeIndex) {}
+    };
+
+    template<typename Function>
+    auto locked(VideoCapture& capture, const Function& function)
+    {
+        const auto release = py::gil_scoped_release();
+        const auto lock = std::lock_guard<std::mutex>(capture.mutex);
+        return function();
+    }
+
+    // note, the buffer is writable so that OpenCV style drawing can be performed in place
+    //
+    py::buffer_info frameBuffer(const Frame& frame)
+    {
+        const auto rows = py::ssize_t(frame.image.rows);
+        const auto cols = py::ssize_t(frame.image.cols);
+        const auto channels = py::ssize_t(frame.image.channels());
+        const auto step = py::ssize_t(frame.image.step[0]);
+        if (channels == 1)
+        {
+            return py::buffer_info(frame.image.data, sizeof(uint8_t), py::format_descriptor<uint8_t>::format(), 2, {rows, cols}, {step, py::ssize_t(1)});
+        }
+
+        return py::buffer_info(frame.image.data, sizeof(uint8_t), py::format_descriptor<uint8_t>::format(), 3, {rows, cols, channels}, {step, channels, py::ssize_t(1)});
+    }
+}
+
+PYBIND11_MODULE(argus_capture, module)
+{
+    module.doc() = "Argus CSI camera capture for the Jetson, with zero copy numpy frames";
+
+    // note, the library reports errors by throwing a std::string
+    //
+    py::register_exception_translator([](std::exception_ptr exception) {
+        try
+        {
+            if (exception) std::rethrow_exception(exception);
+        }
+        catch (const std::string& message)
+        {
+            PyErr_SetString(PyExc_RuntimeError, message.c_str());
+        }
+    });
+
+    py::class_<Frame>(module, "Frame", py::buffer_protocol())
+        .def_buffer(&frameBuffer)
+        .def_property_readonly("array", [](py::object self) {
+            return py::array(frameBuffer(self.cast<const Frame&>()), self);
+        })
+        .def_property_readonly("capture_id", [](const Frame& frame) { return frame.captureId; })
+        .def_property_readonly("timestamp", [](const Frame& frame) { return frame.timestamp; })
+        .def_property_readonly("shape", [](const Frame& frame) {
+            if (frame.image.channels() == 1) return py::make_tuple(frame.image.rows, frame.image.cols);
+            return py::make_tuple(frame.image.rows, frame.image.cols, frame.image.channels());
+        });
+
+    py::class_<bpl::ArgusCameraSettings>(module, "ArgusCameraSettings")
+        .def_readonly_static("AWB_MODE_OFF", &bpl::ArgusCameraSettings::AWB_MODE_OFF)
+        .def_readonly_static("AWB_MODE_AUTO", &bpl::ArgusCameraSettings::AWB_MODE_AUTO)
+        .def_readonly_static("AWB_MODE_INCANDESCENT", &bpl::ArgusCameraSettings::AWB_MODE_INCANDESCENT)
+        .def_readonly_static("AWB_MODE_FLUORESCENT", &bpl::ArgusCameraSettings::AWB_MODE_FLUORESCENT)
+        .def_readonly_static("AWB_MODE_WARM_FLUORESCENT", &bpl::ArgusCameraSettings::AWB_MODE_WARM_FLUORESCENT)
+        .def_readonly_static("AWB_MODE_DAYLIGHT", &bpl::ArgusCameraSettings::AWB_MODE_DAYLIGHT)
+        .def_readonly_static("AWB_MODE_CLOUDY_DAYLIGHT", &bpl::ArgusCameraSettings::AWB_MODE_CLOUDY_DAYLIGHT)
+        .def_readonly_static("AWB_MODE_TWILIGHT", &bpl::ArgusCameraSettings::AWB_MODE_TWILIGHT)
+        .def_readonly_static("AWB_MODE_SHADE", &bpl::ArgusCameraSettings::AWB_MODE_SHADE)
+        .def_readonly_static("AWB_MODE_MANUAL", &bpl::ArgusCameraSettings::AWB_MODE_MANUAL)
+        .def_static("display_attached_camera_info", &bpl::ArgusCameraSettings::displayAttachedCameraInfo)
+        .def("get_frame_duration_range", py::overload_cast<>(&bpl::ArgusCameraSettings::getFrameDurationRange, py::const_))
+        .def("set_frame_duration_range", py::overload_cast<const std::tuple<uint64_t, uint64_t>>(&bpl::ArgusCameraSettings::getFrameDurationRange))
+        .def("get_frame_rate", &bpl::ArgusCameraSettings::getFrameRate)
+        .def("set_frame_rate", &bpl::ArgusCameraSettings::setFrameRate)
+        .def("get_auto_exposure_lock", &bpl::ArgusCameraSettings::getAutoExposureLock)
+        .def("set_auto_exposure_lock", &bpl::ArgusCameraSettings::setAutoExposureLock)
+        .def("get_exposure_time_range", &bpl::ArgusCameraSettings::getExposureTimeRange)
+        .def("set_exposure_time", &bpl::ArgusCameraSettings::setExposureTime)
+        .def("set_exposure_time_range", &bpl::ArgusCameraSettings::setExposureTimeRange)
+        .def("get_gain_range", &bpl::ArgusCameraSettings::getGainRange)
+        .def("set_gain", &bpl::ArgusCameraSettings::setGain)
+        .def("set_gain_range", &bpl::ArgusCameraSettings::setGainRange)
+        .def("get_auto_white_balance_lock", &bpl::ArgusCameraSettings::getAutoWhiteBalanceLock)
+        .def("set_auto_white_balance_lock", &bpl::ArgusCameraSettings::setAutoWhiteBalanceLock)
+        .def("get_auto_white_balance_mode", &bpl::ArgusCameraSettings::getAutoWhiteBalanceMode)
+        .def("get_auto_white_balance_mode_name", &bpl::ArgusCameraSettings::getAutoWhiteBalanceModeName)
+        .def("set_auto_white_balance_mode", &bpl::ArgusCameraSettings::setAutoWhiteBalanceMode);
+
+    // note, keep_alive<0, 1> ties the lifetime of the capture to each returned Frame (or settings instance), as the leased
+    //       DMA buffers are owned by the capture
+    //
+    py::class_<VideoCapture>(module, "ArgusVideoCapture")
+        .def_readonly_static("PIXEL_FORMAT_BGRA", &bpl::ArgusVideoCapture::PIXEL_FORMAT_BGRA)
+        .def_readonly_static("PIXEL_FORMAT_RGBA", &bpl::ArgusVideoCapture::PIXEL_FORMAT_RGBA)
+        .def_readonly_static("PIXEL_FORMAT_GREY", &bpl::ArgusVideoCapture::PIXEL_FORMAT_GREY)
+        .def(py::init<const int32_t, const int32_t>(), py::arg("device_index"), py::arg("sensor_mode_index"),
+            py::call_guard<py::gil_scoped_release>())
+        .def_readonly_static("MAX_LEASED_BUFFERS", &bpl::ArgusVideoCapture::MAX_LEASED_BUFFERS)
+        .def("grab", [](VideoCapture& capture) {
+            locked(capture, [&] { capture.grab(); });
+        })
+        .def("retrieve", [](VideoCapture& capture, const int32_t format, const std::optional<std::tuple<int32_t, int32_t>>& size) {
+            return locked(capture, [&] {
+                const auto frameSize = size ? cv::Size2i(std::get<0>(*size), std::get<1>(*size)) : capture.getResolution();
+                return capture.retrieveLeased(format, frameSize);
+            });
+        }, py::arg("format") = bpl::ArgusVideoCapture::PIXEL_FORMAT_BGRA, py::arg("size") = py::none(), py::keep_alive<0, 1>())
+        .def("read", [](VideoCapture& capture, const int32_t format) {
+            return locked(capture, [&] {
+                capture.grab();
+                return capture.retrieveLeased(format, capture.getResolution());
+            });
+        }, py::arg("format") = bpl::ArgusVideoCapture::PIXEL_FORMAT_BGRA, py::keep_alive<0, 1>())
+        .def("get_resolution", [](const VideoCapture& capture) {
+            const auto resolution = capture.getResolution();
+            return std::make_tuple(resolution.width, resolution.height);
+        })
+        .def("get_timestamp", [](VideoCapture& capture) {
+            return locked(capture, [&] { return capture.getTimestamp(); });
+        })
+        .def("get_capture_id", [](VideoCapture& capture) {
+            return locked(capture, [&] { return capture.getCaptureId(); });
+        })
+        .def("save_as_jpeg", [](VideoCapture& capture, const std::string& fileName) {
+            return locked(capture, [&] { return capture.saveAsJPEG(fileName); });
+        }, py::arg("file_name"))
+        .def("get_camera_settings", &bpl::ArgusVideoCapture::getCameraSettings, py::return_value_policy::reference_internal)
+        .def("restart", [](VideoCapture& capture) {
+            return locked(capture, [&] { return capture.restart(); });
+        });
+}
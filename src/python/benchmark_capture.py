@@ -0,0 +1,118 @@
+#
+# (c) Bit Parallel Ltd, October 2026
+#
+
+# notes 1, compares the argus_capture python bindings with the OpenCV GStreamer (nvarguscamerasrc) capture path
+#       2, both paths run in turn against the same camera and sensor mode, as the camera can only be opened once
+#       3, each frame is reduced to its mean so that the pixel data is actually read, i.e. lazy paths are not flattered
+#       4, reports the frames per second, the mean and 99th percentile time blocked in read() and the mean processing time
+#       5, the GStreamer path ends at nvvidconv with 4 channel BGRx output so that both paths deliver the same pixel layout, the
+#          gstreamer-bgr path adds the usual videoconvert to 3 channel BGR, a CPU conversion and copy, and is reported separately
+#       6, BGRx appsink output requires an OpenCV build whose GStreamer backend accepts BGRx, e.g. OpenCV 4.5 or later
+#
+
+import argparse
+import sys
+import time
+
+import numpy
+
+
+def percentile(samples, fraction):
+    ordered = sorted(samples)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def report(name, frames, elapsed, read_times, process_times):
+    print(f"{name}:")
+    print(f"    Frames: {frames}, FPS: {frames / elapsed:.2f}")
+    print(f"    read(): mean {1000.0 * sum(read_times) / len(read_times):.3f}ms, p99 {1000.0 * percentile(read_times, 0.99):.3f}ms")
+    print(f"    Processing: mean {1000.0 * sum(process_times) / len(process_times):.3f}ms")
+
+
+def benchmark_argus(arguments):
+    import argus_capture
+
+    capture = argus_capture.ArgusVideoCapture(arguments.device, arguments.mode)
+    settings = capture.get_camera_settings()
+    settings.set_frame_rate(arguments.fps)
+    capture.restart()
+
+    for _ in range(arguments.warmup):
+        capture.read()
+
+    read_times, process_times = [], []
+    started = time.perf_counter()
+    for _ in range(arguments.frames):
+        before = time.perf_counter()
+        frame = numpy.asarray(capture.read())
+        after = time.perf_counter()
+        frame.mean()
+        read_times.append(after - before)
+        process_times.append(time.perf_counter() - after)
+
+    report("Argus Bindings (BGRA, zero copy)", arguments.frames, time.perf_counter() - started, read_times, process_times)
+
+
+def benchmark_gstreamer(arguments, convert_to_bgr):
+    import cv2
+
+    output = "videoconvert ! video/x-raw, format=BGR ! " if convert_to_bgr else ""
+    pipeline = (f"nvarguscamerasrc sensor-id={arguments.device} sensor-mode={arguments.mode} ! "
+                f"video/x-raw(memory:NVMM), width={arguments.width}, height={arguments.height}, framerate={int(arguments.fps)}/1 ! "
+                f"nvvidconv ! video/x-raw, format=BGRx ! {output}appsink drop=true max-buffers=1")
+    name = "OpenCV GStreamer (BGR, videoconvert)" if convert_to_bgr else "OpenCV GStreamer (BGRx, nvvidconv)"
+
+    capture = cv2.VideoCapture(pipeline, cv2.CAP_GSTREAMER)
+    if not capture.isOpened():
+        print(f"Error: Unable to open the {name} pipeline, is OpenCV built with GStreamer support (and BGRx appsink support)?")
+        return
+
+    for _ in range(arguments.warmup):
+        capture.read()
+
+    read_times, process_times = [], []
+    started = time.perf_counter()
+    for _ in range(arguments.frames):
+        before = time.perf_counter()
+        success, frame = capture.read()
+        after = time.perf_counter()
+        if not success:
+            print("Error: The GStreamer pipeline failed to deliver a frame")
+            return
+
+        frame.mean()
+        read_times.append(after - before)
+        process_times.append(time.perf_counter() - after)
+
+    report(name, arguments.frames, time.perf_counter() - started, read_times, process_times)
+    capture.release()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Argus bindings vs GStreamer capture benchmark")
+    parser.add_argument("-d", "--device", type=int, default=0, help="camera device index")
+    parser.add_argument("-m", "--mode", type=int, default=0, help="sensor mode index")
+    parser.add_argument("--width", type=int, default=1920, help="sensor mode width, used by the GStreamer caps")
+    parser.add_argument("--height", type=int, default=1080, help="sensor mode height, used by the GStreamer caps")
+    parser.add_argument("--fps", type=float, default=30.0, help="requested frame rate")
+    parser.add_argument("--frames", type=int, default=600, help="number of measured frames")
+    parser.add_argument("--warmup", type=int, default=30, help="number of discarded frames before measuring")
+    parser.add_argument("--path", choices=["argus", "gstreamer", "gstreamer-bgr", "both", "all"], default="both",
+                        help="capture path(s) to benchmark, both is argus and gstreamer, all adds gstreamer-bgr")
+    arguments = parser.parse_args()
+
+    if arguments.path in ("argus", "both", "all"):
+        benchmark_argus(arguments)
+
+    if arguments.path in ("gstreamer", "both", "all"):
+        benchmark_gstreamer(arguments, False)
+
+    if arguments.path in ("gstreamer-bgr", "all"):
+        benchmark_gstreamer(arguments, True)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())